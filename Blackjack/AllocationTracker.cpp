@@ -0,0 +1,218 @@
+#include "AllocationTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace blackjack
+{
+	/// <summary>
+	/// The scope and counts of the current thread. These are plain data, so they never need to allocate anything themselves.
+	/// </summary>
+	static thread_local eAllocationScope t_allocationScope = ALLOCATION_SCOPE_OTHER;
+	static thread_local AllocationCounts t_allocationCounts[TOTAL_ALLOCATION_SCOPES];
+
+	static std::atomic<long long> s_liveBytes(0);
+	static std::atomic<long long> s_peakLiveBytes(0);
+
+	eAllocationScope SetAllocationScope(const eAllocationScope _scope)
+	{
+		const auto previous = t_allocationScope;
+		t_allocationScope = _scope;
+		return previous;
+	}
+
+	void RecordAllocation(const std::size_t _bytes)
+	{
+		auto& counts = t_allocationCounts[t_allocationScope];
+		counts.m_allocations++;
+		counts.m_bytes += (long long)_bytes;
+
+		// The peak only ever goes up, so if another thread has raised it past this in the meantime, there's nothing to do.
+		const auto live = s_liveBytes.fetch_add((long long)_bytes, std::memory_order_relaxed) + (long long)_bytes;
+		auto peak = s_peakLiveBytes.load(std::memory_order_relaxed);
+		while (live > peak && !s_peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void RecordFree(const std::size_t _bytes)
+	{
+		auto& counts = t_allocationCounts[t_allocationScope];
+		counts.m_frees++;
+		counts.m_freedBytes += (long long)_bytes;
+
+		s_liveBytes.fetch_sub((long long)_bytes, std::memory_order_relaxed);
+	}
+
+	void GetAllocationReport(AllocationReport* o_report)
+	{
+		for (auto scope = 0; scope < TOTAL_ALLOCATION_SCOPES; scope++)
+		{
+			o_report->m_scopes[scope] = t_allocationCounts[scope];
+		}
+
+		o_report->m_liveBytes = s_liveBytes.load(std::memory_order_relaxed);
+		o_report->m_peakLiveBytes = s_peakLiveBytes.load(std::memory_order_relaxed);
+	}
+
+	void GetAllocationsSince(const AllocationReport* _start, AllocationReport* o_report)
+	{
+		GetAllocationReport(o_report);
+
+		for (auto scope = 0; scope < TOTAL_ALLOCATION_SCOPES; scope++)
+		{
+			auto& counts = o_report->m_scopes[scope];
+			const auto& start = _start->m_scopes[scope];
+
+			counts.m_allocations -= start.m_allocations;
+			counts.m_bytes -= start.m_bytes;
+			counts.m_frees -= start.m_frees;
+			counts.m_freedBytes -= start.m_freedBytes;
+		}
+	}
+
+	void MergeAllocationReport(AllocationReport* _report, const AllocationReport* _other)
+	{
+		for (auto scope = 0; scope < TOTAL_ALLOCATION_SCOPES; scope++)
+		{
+			auto& counts = _report->m_scopes[scope];
+			const auto& other = _other->m_scopes[scope];
+
+			counts.m_allocations += other.m_allocations;
+			counts.m_bytes += other.m_bytes;
+			counts.m_frees += other.m_frees;
+			counts.m_freedBytes += other.m_freedBytes;
+		}
+
+		_report->m_liveBytes = _other->m_liveBytes > _report->m_liveBytes ? _other->m_liveBytes : _report->m_liveBytes;
+		_report->m_peakLiveBytes = _other->m_peakLiveBytes > _report->m_peakLiveBytes ? _other->m_peakLiveBytes : _report->m_peakLiveBytes;
+	}
+
+	long long GetTotalAllocations(const AllocationReport* _report)
+	{
+		long long allocations = 0;
+		for (auto scope = 0; scope < TOTAL_ALLOCATION_SCOPES; scope++)
+		{
+			allocations += _report->m_scopes[scope].m_allocations;
+		}
+
+		return allocations;
+	}
+
+	void DisplayAllocationReport(std::ostream& _output, const AllocationReport* _report)
+	{
+		for (auto scope = 0; scope < TOTAL_ALLOCATION_SCOPES; scope++)
+		{
+			const auto& counts = _report->m_scopes[scope];
+			if (counts.m_allocations == 0 && counts.m_frees == 0)
+			{
+				continue;
+			}
+
+			_output << " " << c_allocationScopeNames[scope] << ": " << counts.m_allocations << " allocations (" << counts.m_bytes << " bytes), " <<
+				counts.m_frees << " frees (" << counts.m_freedBytes << " bytes)\n";
+		}
+
+		_output << " Live: " << _report->m_liveBytes << " bytes, Peak: " << _report->m_peakLiveBytes << " bytes\n";
+	}
+}
+
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+
+/// <summary>
+/// Every tracked allocation has its size stored just before it, so it can be recorded again when it's freed.<br>
+/// This is as big as the strictest alignment plain new guarantees, so the memory after it stays just as aligned.
+/// </summary>
+constexpr std::size_t c_allocationHeaderSize = 16;
+
+/// <summary>
+/// Allocate memory with its size in front of it, and record it against the current thread's scope.
+/// </summary>
+static void* AllocateTracked(const std::size_t _size) noexcept
+{
+	auto* block = (unsigned char*)std::malloc(_size + c_allocationHeaderSize);
+	if (block == nullptr)
+	{
+		return nullptr;
+	}
+
+	*(std::size_t*)block = _size;
+	blackjack::RecordAllocation(_size);
+	return block + c_allocationHeaderSize;
+}
+
+/// <summary>
+/// Free memory from AllocateTracked, and record it against the current thread's scope.
+/// </summary>
+static void FreeTracked(void* _pointer) noexcept
+{
+	if (_pointer == nullptr)
+	{
+		return;
+	}
+
+	auto* block = (unsigned char*)_pointer - c_allocationHeaderSize;
+	blackjack::RecordFree(*(std::size_t*)block);
+	std::free(block);
+}
+
+// Replacing the global operators sends every plain new and delete in the program through the tracker, including the standard library's.
+void* operator new(const std::size_t _size)
+{
+	auto* pointer = AllocateTracked(_size);
+	if (pointer == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	return pointer;
+}
+
+void* operator new[](const std::size_t _size)
+{
+	return operator new(_size);
+}
+
+void* operator new(const std::size_t _size, const std::nothrow_t&) noexcept
+{
+	return AllocateTracked(_size);
+}
+
+void* operator new[](const std::size_t _size, const std::nothrow_t&) noexcept
+{
+	return AllocateTracked(_size);
+}
+
+void operator delete(void* _pointer) noexcept
+{
+	FreeTracked(_pointer);
+}
+
+void operator delete[](void* _pointer) noexcept
+{
+	FreeTracked(_pointer);
+}
+
+void operator delete(void* _pointer, std::size_t) noexcept
+{
+	FreeTracked(_pointer);
+}
+
+void operator delete[](void* _pointer, std::size_t) noexcept
+{
+	FreeTracked(_pointer);
+}
+
+void operator delete(void* _pointer, const std::nothrow_t&) noexcept
+{
+	FreeTracked(_pointer);
+}
+
+void operator delete[](void* _pointer, const std::nothrow_t&) noexcept
+{
+	FreeTracked(_pointer);
+}
+
+#endif
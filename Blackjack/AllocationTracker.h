@@ -0,0 +1,147 @@
+#pragma once
+
+#ifndef ALLOCATION_TRACKER_H_
+#define ALLOCATION_TRACKER_H_
+
+#include <cstddef>
+#include <iosfwd>
+
+// Allocation tracking is opt-in, by defining BLACKJACK_TRACK_ALLOCATIONS for the whole project.
+// Without it, none of the global operators are replaced and every macro below compiles to nothing, so normal builds pay nothing for it.
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+#define BEGIN_ALLOCATION_SCOPE(_scope) const auto previousAllocationScope = blackjack::SetAllocationScope(_scope)
+#define END_ALLOCATION_SCOPE() blackjack::SetAllocationScope(previousAllocationScope)
+#define RECORD_ALLOCATION(_bytes) blackjack::RecordAllocation(_bytes)
+#define RECORD_FREE(_bytes) blackjack::RecordFree(_bytes)
+#else
+#define BEGIN_ALLOCATION_SCOPE(_scope) (void)0
+#define END_ALLOCATION_SCOPE() (void)0
+#define RECORD_ALLOCATION(_bytes) (void)0
+#define RECORD_FREE(_bytes) (void)0
+#endif
+
+namespace blackjack
+{
+	/// <summary>
+	/// Whether this program was built with allocation tracking. If not, every report is always empty.
+	/// </summary>
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+	constexpr auto c_trackAllocations = true;
+#else
+	constexpr auto c_trackAllocations = false;
+#endif
+
+	/// <summary>
+	/// The amount of rounds in each window a simulation checks for allocations, on top of checking each session as a whole.
+	/// </summary>
+	constexpr auto c_allocationWindowRounds = 1000;
+
+	/// <summary>
+	/// Everything an allocation can be attributed to. Each thread is always in exactly one scope, which is "other" unless something says otherwise.<br>
+	/// Includes a value to refer to for the total amount of scopes, which should not be used as a scope ever.
+	/// </summary>
+	enum eAllocationScope : int
+	{
+		ALLOCATION_SCOPE_OTHER = 0,
+		ALLOCATION_SCOPE_INIT_GAME,
+		ALLOCATION_SCOPE_GENERATE_SHOE,
+		ALLOCATION_SCOPE_POPULATE_SHOE,
+		ALLOCATION_SCOPE_CREATE_PLAYER,
+		ALLOCATION_SCOPE_RESET_GAME,
+		ALLOCATION_SCOPE_BET,
+		ALLOCATION_SCOPE_DEAL,
+		ALLOCATION_SCOPE_PLAYER_TURN,
+		ALLOCATION_SCOPE_DEALER_TURN,
+		ALLOCATION_SCOPE_SETTLE,
+		ALLOCATION_SCOPE_END_GAME,
+		TOTAL_ALLOCATION_SCOPES
+	};
+
+	/// <summary>
+	/// String values for every scope name.<br>
+	/// Includes an additional blank value for the TOTAL_ALLOCATION_SCOPES value, just in-case.
+	/// </summary>
+	constexpr char c_allocationScopeNames[][14] = { "Other", "InitGame", "GenerateShoe", "PopulateShoe", "CreatePlayer", "ResetGame", "Bet", "Deal",
+		"Player Turn", "Dealer Turn", "Settle", "EndGame", "" };
+
+	/// <summary>
+	/// Everything allocated and freed in one scope.
+	/// </summary>
+	struct AllocationCounts
+	{
+		long long m_allocations;
+		long long m_bytes;
+		long long m_frees;
+		long long m_freedBytes;
+	};
+
+	/// <summary>
+	/// A snapshot of one thread's allocations in every scope, along with the whole program's live memory at the time.
+	/// </summary>
+	struct AllocationReport
+	{
+		AllocationCounts m_scopes[TOTAL_ALLOCATION_SCOPES];
+
+		/// <summary>
+		/// The amount of bytes allocated and not yet freed, by every thread, and the most there have ever been at once.<br>
+		/// Memory can be freed by a different thread than allocated it, so these are only meaningful for the program as a whole.
+		/// </summary>
+		long long m_liveBytes;
+		long long m_peakLiveBytes;
+	};
+
+	/// <summary>
+	/// Attribute everything this thread allocates from now on to a scope. Use BEGIN_ALLOCATION_SCOPE rather than calling this directly.
+	/// </summary>
+	/// <param name="_scope">The new scope.</param>
+	/// <returns>The scope the thread was in before, to be put back once the new scope ends.</returns>
+	eAllocationScope SetAllocationScope(eAllocationScope _scope);
+
+	/// <summary>
+	/// Record an allocation that didn't go through the global operator new, i.e. an aligned allocation. Use RECORD_ALLOCATION instead.
+	/// </summary>
+	/// <param name="_bytes">The size of the allocation.</param>
+	void RecordAllocation(std::size_t _bytes);
+
+	/// <summary>
+	/// Record a free that didn't go through the global operator delete. Use RECORD_FREE instead.
+	/// </summary>
+	/// <param name="_bytes">The size of the allocation being freed.</param>
+	void RecordFree(std::size_t _bytes);
+
+	/// <summary>
+	/// Take a snapshot of everything this thread has allocated so far.
+	/// </summary>
+	/// <param name="o_report">The report to be output into.</param>
+	void GetAllocationReport(AllocationReport* o_report);
+
+	/// <summary>
+	/// Take a snapshot of everything this thread has allocated since an earlier snapshot.
+	/// </summary>
+	/// <param name="_start">The earlier snapshot, taken on this thread.</param>
+	/// <param name="o_report">The report to be output into.</param>
+	void GetAllocationsSince(const AllocationReport* _start, AllocationReport* o_report);
+
+	/// <summary>
+	/// Add the counts from one report onto another. The live bytes are taken from whichever report has the most.
+	/// </summary>
+	/// <param name="_report">The report to be added onto.</param>
+	/// <param name="_other">The report to add.</param>
+	void MergeAllocationReport(AllocationReport* _report, const AllocationReport* _other);
+
+	/// <summary>
+	/// Get the amount of allocations in a report, across every scope.
+	/// </summary>
+	/// <param name="_report">The report to count.</param>
+	/// <returns>The total amount of allocations.</returns>
+	long long GetTotalAllocations(const AllocationReport* _report);
+
+	/// <summary>
+	/// Display every scope that allocated or freed anything, then the live memory.
+	/// </summary>
+	/// <param name="_output">The stream to display the report to.</param>
+	/// <param name="_report">The report to display.</param>
+	void DisplayAllocationReport(std::ostream& _output, const AllocationReport* _report);
+}
+
+#endif
@@ -0,0 +1,267 @@
+#include "BatchRandom.h"
+
+#include <immintrin.h>
+#include <intrin.h>
+
+#include "Random.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// Map the top 32 bits of a random value evenly onto [0, _bound), the same way as RandomRange.
+	/// </summary>
+	static unsigned short GetBoundedSwap(const unsigned long long _value, const int _bound)
+	{
+		return (unsigned short)(((_value >> 32) * (unsigned long long)_bound) >> 32);
+	}
+
+	/// <summary>
+	/// Advance every lane once without any vector instructions, and get each lane's next value.
+	/// </summary>
+	static void AdvanceBatchRandomScalar(BatchRandom* _random, unsigned long long o_values[c_batchRandomLanes])
+	{
+		for (auto lane = 0; lane < c_batchRandomLanes; lane++)
+		{
+			auto& s0 = _random->m_state[0][lane];
+			auto& s1 = _random->m_state[1][lane];
+			auto& s2 = _random->m_state[2][lane];
+			auto& s3 = _random->m_state[3][lane];
+
+			// xoshiro256+. Its lowest bits are weak, but only the top 32 are ever used.
+			o_values[lane] = s0 + s3;
+
+			const auto shifted = s1 << 17;
+			s2 ^= s0;
+			s3 ^= s1;
+			s1 ^= s2;
+			s0 ^= s3;
+			s2 ^= shifted;
+			s3 = s3 << 45 | s3 >> 19;
+		}
+	}
+
+	static void GenerateShuffleSwapsScalar(BatchRandom* _random, unsigned short o_swaps[], const int _size)
+	{
+		// Each advance fills a block of positions from the top down. Lane N goes to the Nth position from the bottom of the block.
+		// Once the block runs past the first card, the lanes that would go below it are thrown away.
+		unsigned long long values[c_batchRandomLanes];
+		for (auto top = _size - 1; top > 0; top -= c_batchRandomLanes)
+		{
+			AdvanceBatchRandomScalar(_random, values);
+
+			const auto bottom = top - c_batchRandomLanes + 1;
+			for (auto lane = bottom < 1 ? 1 - bottom : 0; lane < c_batchRandomLanes; lane++)
+			{
+				o_swaps[bottom + lane] = GetBoundedSwap(values[lane], bottom + lane + 1);
+			}
+		}
+	}
+
+	/// <summary>
+	/// Store a block of swap targets, one per lane, from the bottom of the block upwards.
+	/// The last block may run past the first card, in which case it has to be stored one lane at a time.
+	/// </summary>
+	static void StoreSwapBlock(unsigned short o_swaps[], const int _bottom, const __m128i _swaps)
+	{
+		if (_bottom >= 1)
+		{
+			_mm_storeu_si128((__m128i*)&o_swaps[_bottom], _swaps);
+			return;
+		}
+
+		unsigned short swaps[c_batchRandomLanes];
+		_mm_storeu_si128((__m128i*)swaps, _swaps);
+		for (auto lane = 1 - _bottom; lane < c_batchRandomLanes; lane++)
+		{
+			o_swaps[_bottom + lane] = swaps[lane];
+		}
+	}
+
+	/// <summary>
+	/// Advance four lanes at once, and get their swap targets for a set of bounds.
+	/// </summary>
+	static __m256i AdvanceBatchRandomAVX2(__m256i& _s0, __m256i& _s1, __m256i& _s2, __m256i& _s3, const __m256i _bounds)
+	{
+		const auto values = _mm256_add_epi64(_s0, _s3);
+
+		const auto shifted = _mm256_slli_epi64(_s1, 17);
+		_s2 = _mm256_xor_si256(_s2, _s0);
+		_s3 = _mm256_xor_si256(_s3, _s1);
+		_s1 = _mm256_xor_si256(_s1, _s2);
+		_s0 = _mm256_xor_si256(_s0, _s3);
+		_s2 = _mm256_xor_si256(_s2, shifted);
+		_s3 = _mm256_or_si256(_mm256_slli_epi64(_s3, 45), _mm256_srli_epi64(_s3, 19));
+
+		// The multiply only uses the low 32 bits of each lane, which is exactly the top half of each value once shifted down.
+		return _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(values, 32), _bounds), 32);
+	}
+
+	static void GenerateShuffleSwapsAVX2(BatchRandom* _random, unsigned short o_swaps[], const int _size)
+	{
+		// Eight lanes don't fit in one register, so they're kept as two halves of four.
+		__m256i state[4][2];
+		for (auto word = 0; word < 4; word++)
+		{
+			state[word][0] = _mm256_loadu_si256((const __m256i*)&_random->m_state[word][0]);
+			state[word][1] = _mm256_loadu_si256((const __m256i*)&_random->m_state[word][4]);
+		}
+
+		// Each lane's bound is one more than the position it's for, and every position moves down a whole block each time.
+		const auto bottom = _size - c_batchRandomLanes;
+		auto lowBounds = _mm256_set_epi64x(bottom + 4, bottom + 3, bottom + 2, bottom + 1);
+		auto highBounds = _mm256_set_epi64x(bottom + 8, bottom + 7, bottom + 6, bottom + 5);
+		const auto step = _mm256_set1_epi64x(c_batchRandomLanes);
+
+		// Every swap target fits in 32 bits, so the low half of each lane is gathered to the bottom before packing them down to 16.
+		const auto gather = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+		for (auto top = _size - 1; top > 0; top -= c_batchRandomLanes)
+		{
+			const auto low = AdvanceBatchRandomAVX2(state[0][0], state[1][0], state[2][0], state[3][0], lowBounds);
+			const auto high = AdvanceBatchRandomAVX2(state[0][1], state[1][1], state[2][1], state[3][1], highBounds);
+			lowBounds = _mm256_sub_epi64(lowBounds, step);
+			highBounds = _mm256_sub_epi64(highBounds, step);
+
+			const auto packed = _mm256_permutevar8x32_epi32(_mm256_blend_epi32(low, _mm256_slli_epi64(high, 32), 0xAA), gather);
+			StoreSwapBlock(o_swaps, top - c_batchRandomLanes + 1,
+				_mm_packus_epi32(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1)));
+		}
+
+		for (auto word = 0; word < 4; word++)
+		{
+			_mm256_storeu_si256((__m256i*)&_random->m_state[word][0], state[word][0]);
+			_mm256_storeu_si256((__m256i*)&_random->m_state[word][4], state[word][1]);
+		}
+	}
+
+	static void GenerateShuffleSwapsAVX512(BatchRandom* _random, unsigned short o_swaps[], const int _size)
+	{
+		auto s0 = _mm512_loadu_si512(&_random->m_state[0][0]);
+		auto s1 = _mm512_loadu_si512(&_random->m_state[1][0]);
+		auto s2 = _mm512_loadu_si512(&_random->m_state[2][0]);
+		auto s3 = _mm512_loadu_si512(&_random->m_state[3][0]);
+
+		const auto bottom = _size - c_batchRandomLanes;
+		auto bounds = _mm512_set_epi64(bottom + 8, bottom + 7, bottom + 6, bottom + 5, bottom + 4, bottom + 3, bottom + 2, bottom + 1);
+		const auto step = _mm512_set1_epi64(c_batchRandomLanes);
+
+		for (auto top = _size - 1; top > 0; top -= c_batchRandomLanes)
+		{
+			const auto values = _mm512_add_epi64(s0, s3);
+
+			const auto shifted = _mm512_slli_epi64(s1, 17);
+			s2 = _mm512_xor_si512(s2, s0);
+			s3 = _mm512_xor_si512(s3, s1);
+			s1 = _mm512_xor_si512(s1, s2);
+			s0 = _mm512_xor_si512(s0, s3);
+			s2 = _mm512_xor_si512(s2, shifted);
+			s3 = _mm512_rol_epi64(s3, 45);
+
+			const auto swaps = _mm512_srli_epi64(_mm512_mul_epu32(_mm512_srli_epi64(values, 32), bounds), 32);
+			bounds = _mm512_sub_epi64(bounds, step);
+
+			StoreSwapBlock(o_swaps, top - c_batchRandomLanes + 1, _mm512_cvtepi64_epi16(swaps));
+		}
+
+		_mm512_storeu_si512(&_random->m_state[0][0], s0);
+		_mm512_storeu_si512(&_random->m_state[1][0], s1);
+		_mm512_storeu_si512(&_random->m_state[2][0], s2);
+		_mm512_storeu_si512(&_random->m_state[3][0], s3);
+	}
+
+	/// <summary>
+	/// Ask the CPU which instruction sets it has, and ask the operating system whether it saves their registers.
+	/// </summary>
+	static eInstructionSet DetectInstructionSet()
+	{
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+		{
+			return INSTRUCTION_SET_SCALAR;
+		}
+
+		// Without OSXSAVE and AVX, none of the wider registers can be used at all.
+		__cpuid(info, 1);
+		if ((info[2] & 1 << 27) == 0 || (info[2] & 1 << 28) == 0)
+		{
+			return INSTRUCTION_SET_SCALAR;
+		}
+
+		const auto enabledRegisters = _xgetbv(0);
+		__cpuidex(info, 7, 0);
+
+		// Bits 1 and 2 are the SSE and AVX registers. Bits 5 to 7 are the AVX-512 mask and upper registers.
+		if ((enabledRegisters & 0xE6) == 0xE6 && (info[1] & 1 << 16) != 0)
+		{
+			return INSTRUCTION_SET_AVX512;
+		}
+		if ((enabledRegisters & 0x6) == 0x6 && (info[1] & 1 << 5) != 0)
+		{
+			return INSTRUCTION_SET_AVX2;
+		}
+
+		return INSTRUCTION_SET_SCALAR;
+	}
+
+	void SeedBatchRandom(BatchRandom* _random, const unsigned long long _seed)
+	{
+		// xoshiro can't be seeded with all zeroes, so every word comes from a SplitMix64 stream instead.
+		Random seeder;
+		SeedRandom(&seeder, _seed);
+
+		for (auto lane = 0; lane < c_batchRandomLanes; lane++)
+		{
+			for (auto word = 0; word < 4; word++)
+			{
+				_random->m_state[word][lane] = NextRandom(&seeder);
+			}
+		}
+	}
+
+	eInstructionSet GetSupportedInstructionSet()
+	{
+		static const auto instructionSet = DetectInstructionSet();
+		return instructionSet;
+	}
+
+	const char* GetInstructionSetName(const eInstructionSet _instructionSet)
+	{
+		return c_instructionSetNames[_instructionSet];
+	}
+
+	void GenerateShuffleSwaps(BatchRandom* _random, unsigned short o_swaps[], const int _size)
+	{
+		GenerateShuffleSwaps(_random, o_swaps, _size, GetSupportedInstructionSet());
+	}
+
+	void GenerateShuffleSwaps(BatchRandom* _random, unsigned short o_swaps[], const int _size, const eInstructionSet _instructionSet)
+	{
+		// The first card can only ever swap with itself.
+		if (_size > 0)
+		{
+			o_swaps[0] = 0;
+		}
+
+		switch (_instructionSet)
+		{
+			case INSTRUCTION_SET_AVX512:
+			{
+				GenerateShuffleSwapsAVX512(_random, o_swaps, _size);
+				break;
+			}
+
+			case INSTRUCTION_SET_AVX2:
+			{
+				GenerateShuffleSwapsAVX2(_random, o_swaps, _size);
+				break;
+			}
+
+			default:
+			{
+				GenerateShuffleSwapsScalar(_random, o_swaps, _size);
+				break;
+			}
+		}
+	}
+}
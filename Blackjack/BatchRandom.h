@@ -0,0 +1,77 @@
+#pragma once
+
+#ifndef BATCH_RANDOM_H_
+#define BATCH_RANDOM_H_
+
+namespace blackjack
+{
+	/// <summary>
+	/// The amount of independent streams in a batch generator. This is fixed on every instruction set, so that they all give the same numbers.
+	/// </summary>
+	constexpr auto c_batchRandomLanes = 8;
+
+	/// <summary>
+	/// Every instruction set that a batch generator can be advanced with, from slowest to fastest.<br>
+	/// Includes a value to refer to for the total amount of instruction sets, which should not be used as an instruction set ever.
+	/// </summary>
+	enum eInstructionSet : int
+	{
+		INSTRUCTION_SET_SCALAR = 0,
+		INSTRUCTION_SET_AVX2,
+		INSTRUCTION_SET_AVX512,
+		TOTAL_INSTRUCTION_SETS
+	};
+
+	constexpr char c_instructionSetNames[][8] = { "Scalar", "AVX2", "AVX-512", "" };
+
+	/// <summary>
+	/// A random number generator made of "c_batchRandomLanes" xoshiro256+ streams, which are all advanced at once.<br>
+	/// Numbers are taken from each lane in turn, so the output is exactly the same however many lanes are advanced per instruction.
+	/// </summary>
+	struct BatchRandom
+	{
+		/// <summary>
+		/// Every lane's state, stored word by word so that each word of every lane can be loaded into a single register.
+		/// </summary>
+		unsigned long long m_state[4][c_batchRandomLanes];
+	};
+
+	/// <summary>
+	/// Reset a batch generator to a known starting point. The same seed will always produce the same numbers.
+	/// </summary>
+	/// <param name="_random">The generator to be seeded.</param>
+	/// <param name="_seed">Any value. Zero is fine, too.</param>
+	void SeedBatchRandom(BatchRandom* _random, unsigned long long _seed);
+
+	/// <summary>
+	/// Get the fastest instruction set that both this CPU and the operating system support. This is only checked once.
+	/// </summary>
+	/// <returns>The instruction set that batch generators use by default.</returns>
+	eInstructionSet GetSupportedInstructionSet();
+
+	/// <summary>
+	/// Get a string value to display an instruction set's name.
+	/// </summary>
+	/// <param name="_instructionSet">The instruction set.</param>
+	/// <returns>A pointer to a constant char array containing the instruction set's name.</returns>
+	const char* GetInstructionSetName(eInstructionSet _instructionSet);
+
+	/// <summary>
+	/// Fill a block with Fisher-Yates swap targets, using the fastest supported instruction set.
+	/// </summary>
+	/// <param name="_random">The generator to advance.</param>
+	/// <param name="o_swaps">The array to be output into, where o_swaps[i] is a random position from 0 to i (inclusive). MUST be at least "_size" long.</param>
+	/// <param name="_size">The amount of cards to be shuffled.</param>
+	void GenerateShuffleSwaps(BatchRandom* _random, unsigned short o_swaps[], int _size);
+
+	/// <summary>
+	/// Fill a block with Fisher-Yates swap targets, using a specific instruction set. Every instruction set gives the same swaps.
+	/// </summary>
+	/// <param name="_random">The generator to advance.</param>
+	/// <param name="o_swaps">The array to be output into, where o_swaps[i] is a random position from 0 to i (inclusive). MUST be at least "_size" long.</param>
+	/// <param name="_size">The amount of cards to be shuffled.</param>
+	/// <param name="_instructionSet">The instruction set to use. MUST be supported, see GetSupportedInstructionSet.</param>
+	void GenerateShuffleSwaps(BatchRandom* _random, unsigned short o_swaps[], int _size, eInstructionSet _instructionSet);
+}
+
+#endif
@@ -0,0 +1,89 @@
+#include "BetPolicy.h"
+
+#include "AllocationTracker.h"
+
+namespace blackjack
+{
+	BetPolicy GetDefaultBetPolicy(const eBetPolicy _type, const int _baseBet, const int _maxBet)
+	{
+		// A fairly typical 1-8 spread, with the usual Hi-Lo estimates of roughly +0.5% edge per true count.
+		BetPolicy policy{ _type, _baseBet, _maxBet, { 1, 1, 2, 4, 6, 8, 8 }, 0.5, -0.005, 0.005, 1.3 };
+
+		// A max bet below the base bet would cap every bet under the smallest one asked for, so it's raised to the base bet instead.
+		if (_type == BET_POLICY_FLAT || _maxBet < _baseBet)
+		{
+			policy.m_maxBet = _baseBet;
+		}
+
+		return policy;
+	}
+
+	const char* GetBetPolicyName(const eBetPolicy _type)
+	{
+		return c_betPolicyNames[_type];
+	}
+
+	int SelectPolicyBet(const BetPolicy* _policy, const BetState* _state, const Game* _game)
+	{
+		return SelectPolicyBet(_policy, _state, _game->m_players[PLAYER_PLAYER]->m_bank, GetTrueCount(_game->m_shoe));
+	}
+
+	int SelectPolicyBet(const BetPolicy* _policy, const BetState* _state, const int _bank, const int _trueCount)
+	{
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_BET);
+
+		auto bet = _policy->m_baseBet;
+		switch (_policy->m_type)
+		{
+			case BET_POLICY_COUNT_SPREAD:
+			{
+				const auto step = _trueCount < 0 ? 0 : _trueCount > c_spreadSteps ? c_spreadSteps : _trueCount;
+
+				bet = _policy->m_baseBet * _policy->m_spread[step];
+				break;
+			}
+
+			case BET_POLICY_KELLY:
+			{
+				// Kelly bets the edge over the variance as a fraction of the bank. With no edge, it falls back to the minimum.
+				const auto edge = _policy->m_baseEdge + _policy->m_edgePerTrueCount * _trueCount;
+				if (edge > 0.0)
+				{
+					bet = (int)((double)_bank * _policy->m_kellyFraction * edge / _policy->m_variance);
+				}
+				break;
+			}
+
+			case BET_POLICY_MARTINGALE:
+			{
+				// Double the bet after every loss. The shift is capped, since the max bet will cut it down long before then anyway.
+				bet = _policy->m_baseBet << (_state->m_lossStreak < 20 ? _state->m_lossStreak : 20);
+				break;
+			}
+
+			default:
+			{
+				break;
+			}
+		}
+
+		// The policy can't go outside its own limits, and the player can obviously only bet money they actually have!
+		bet = bet < _policy->m_baseBet ? _policy->m_baseBet : bet > _policy->m_maxBet ? _policy->m_maxBet : bet;
+
+		END_ALLOCATION_SCOPE();
+		return bet < _bank ? bet : _bank;
+	}
+
+	void UpdateBetState(BetState* _state, const eHandValidityComparison _result)
+	{
+		// A tie doesn't win anything back, but it doesn't lose anything either, so the streak carries on as it was.
+		if (_result == HAND_COMPARISON_LOSS)
+		{
+			_state->m_lossStreak++;
+		}
+		else if (_result != HAND_COMPARISON_TIE)
+		{
+			_state->m_lossStreak = 0;
+		}
+	}
+}
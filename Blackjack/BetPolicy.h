@@ -0,0 +1,127 @@
+#pragma once
+
+#ifndef BET_POLICY_H_
+#define BET_POLICY_H_
+
+#include "Game.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// Every built-in way of choosing a bet in simulation mode.<br>
+	/// Includes a value to refer to for the total amount of policies, which should not be assigned to a policy ever.
+	/// </summary>
+	enum eBetPolicy : int
+	{
+		BET_POLICY_FLAT = 0,
+		BET_POLICY_COUNT_SPREAD,
+		BET_POLICY_KELLY,
+		BET_POLICY_MARTINGALE,
+		TOTAL_BET_POLICIES
+	};
+
+	/// <summary>
+	/// String values for every bet policy name.<br>
+	/// Includes an additional blank value for the TOTAL_BET_POLICIES value, just in-case.
+	/// </summary>
+	constexpr char c_betPolicyNames[][13] = { "Flat", "Count Spread", "Kelly", "Martingale", "" };
+
+	/// <summary>
+	/// The count spread has one step per true count, from 0 up to this. Counts below 0 use the first step, above it the last.
+	/// </summary>
+	constexpr auto c_spreadSteps = 6;
+
+	/// <summary>
+	/// Everything needed to choose a bet. This is plain data, so choosing a bet never allocates anything.
+	/// </summary>
+	struct BetPolicy
+	{
+		eBetPolicy m_type;
+
+		/// <summary>
+		/// The smallest bet the policy makes, i.e. the flat bet, or the unit the spread and Martingale are measured in.
+		/// </summary>
+		int m_baseBet;
+
+		/// <summary>
+		/// The largest bet the policy is allowed to make. Bets are always limited to the player's bank as well.
+		/// </summary>
+		int m_maxBet;
+
+		/// <summary>
+		/// Count spread: how many base bets to make at each true count.
+		/// </summary>
+		int m_spread[c_spreadSteps + 1];
+
+		/// <summary>
+		/// Kelly: the fraction of the full Kelly bet to make. 1 is full Kelly, 0.5 is half Kelly, and so on.
+		/// </summary>
+		double m_kellyFraction;
+
+		/// <summary>
+		/// Kelly: the player's edge at a true count of 0, and how much it changes with each true count.
+		/// </summary>
+		double m_baseEdge;
+		double m_edgePerTrueCount;
+
+		/// <summary>
+		/// Kelly: the variance of a single round, measured in bets.
+		/// </summary>
+		double m_variance;
+	};
+
+	/// <summary>
+	/// Whatever a policy needs to remember between rounds of one session. Must be reset at the start of every session.
+	/// </summary>
+	struct BetState
+	{
+		/// <summary>
+		/// The amount of rounds lost in a row, for progressive policies.
+		/// </summary>
+		int m_lossStreak;
+	};
+
+	/// <summary>
+	/// Get a policy filled with sensible defaults for its type.
+	/// </summary>
+	/// <param name="_type">The type of policy.</param>
+	/// <param name="_baseBet">The smallest bet the policy makes.</param>
+	/// <param name="_maxBet">The largest bet the policy makes. Ignored by the flat policy, and raised to the base bet if it's any lower.</param>
+	/// <returns>The filled policy.</returns>
+	BetPolicy GetDefaultBetPolicy(eBetPolicy _type, int _baseBet, int _maxBet);
+
+	/// <summary>
+	/// Get a string value to display a policy's name.
+	/// </summary>
+	/// <param name="_type">The type of policy.</param>
+	/// <returns>A 13-byte long const char array of the policy's name.</returns>
+	const char* GetBetPolicyName(eBetPolicy _type);
+
+	/// <summary>
+	/// Choose the next bet for a session, reading the player's bank and the shoe straight out of the game.
+	/// </summary>
+	/// <param name="_policy">The policy to choose with.</param>
+	/// <param name="_state">The session's state.</param>
+	/// <param name="_game">The game instance.</param>
+	/// <returns>The bet, from 1 to the player's bank. The player's bank MUST be at least 1.</returns>
+	int SelectPolicyBet(const BetPolicy* _policy, const BetState* _state, const Game* _game);
+
+	/// <summary>
+	/// Choose the next bet for a session, from a bank and true count that have already been read out of wherever they're kept.
+	/// </summary>
+	/// <param name="_policy">The policy to choose with.</param>
+	/// <param name="_state">The session's state.</param>
+	/// <param name="_bank">The player's bank. MUST be at least 1.</param>
+	/// <param name="_trueCount">The shoe's Hi-Lo true count, as given by GetTrueCount.</param>
+	/// <returns>The bet, from 1 to the player's bank.</returns>
+	int SelectPolicyBet(const BetPolicy* _policy, const BetState* _state, int _bank, int _trueCount);
+
+	/// <summary>
+	/// Tell a session's state how a round went, so progressive policies can change the next bet.
+	/// </summary>
+	/// <param name="_state">The session's state.</param>
+	/// <param name="_result">The player's hand compared to the dealer's.</param>
+	void UpdateBetState(BetState* _state, eHandValidityComparison _result);
+}
+
+#endif
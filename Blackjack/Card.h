@@ -9,7 +9,7 @@ namespace blackjack
 	/// Card suit enum.<br>
 	/// Includes a value to refer to for the total amount of suits, which should not be assigned to a value ever.
 	/// </summary>
-	enum eSuit : int
+	enum eSuit : unsigned char
 	{
 		SUIT_HEARTS = 0,
 		SUIT_DIAMONDS,
@@ -22,7 +22,7 @@ namespace blackjack
 	/// Card rank enum.<br>
 	/// Includes a value to refer to for the total amount of ranks, which should not be assigned to a value ever.
 	/// </summary>
-	enum eRank : int
+	enum eRank : unsigned char
 	{
 		RANK_ACE = 0,
 		RANK_TWO,
@@ -64,7 +64,8 @@ namespace blackjack
 
 	/// <summary>
 	/// All data that is necessary to store for a card.<br>
-	/// Cards will, in memory, always keep their suit and rank but these should be hidden from the user if m_visible is false.
+	/// Cards will, in memory, always keep their suit and rank but these should be hidden from the user if m_visible is false.<br>
+	/// Suits and ranks are stored as single bytes, so a card is small enough to be copied into a hand rather than pointed to.
 	/// </summary>
 	struct Card
 	{
@@ -0,0 +1,175 @@
+#include "Export.h"
+
+#include <cstring>
+
+namespace blackjack
+{
+	ExportWriter* CreateExportWriter(const char _path[], const eExportFormat _format)
+	{
+		FILE* file = nullptr;
+		if (fopen_s(&file, _path, _format == EXPORT_FORMAT_CSV ? "w" : "wb") != 0 || file == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto* writer = new ExportWriter{ file, _format, false, {} };
+
+		if (_format == EXPORT_FORMAT_CSV)
+		{
+			for (auto column = 0; column < TOTAL_EXPORT_COLUMNS; column++)
+			{
+				writer->m_failed |= fprintf(file, column == 0 ? "%s" : ",%s", c_exportColumnNames[column]) < 0;
+			}
+			writer->m_failed |= fprintf(file, "\n") < 0;
+		}
+		else
+		{
+			ExportFileHeader header{};
+			memcpy(header.m_magic, c_exportMagic, sizeof(c_exportMagic));
+			header.m_version = 1;
+			header.m_columnCount = TOTAL_EXPORT_COLUMNS;
+			memcpy(header.m_columnWidths, c_exportColumnWidths, sizeof(header.m_columnWidths));
+
+			writer->m_failed |= fwrite(&header, sizeof(header), 1, file) != 1;
+		}
+
+		return writer;
+	}
+
+	bool DestroyExportWriter(ExportWriter*& _writer)
+	{
+		// Closing writes out whatever the file was still holding on to, so that can fail too.
+		const auto closed = fclose(_writer->m_file) == 0;
+		const auto succeeded = closed && !_writer->m_failed;
+
+		delete _writer;
+		_writer = nullptr;
+
+		return succeeded;
+	}
+
+	ExportBuffer* CreateExportBuffer(ExportWriter* _writer)
+	{
+		// A buffer is several megabytes, so it's only zeroed as rows are added rather than all at once.
+		auto* buffer = new ExportBuffer;
+		buffer->m_writer = _writer;
+		buffer->m_rows = 0;
+
+		return buffer;
+	}
+
+	void DestroyExportBuffer(ExportBuffer*& _buffer)
+	{
+		// Anything left over is a partial block, which is written out as a smaller block of its own.
+		FlushExportBuffer(_buffer);
+
+		delete _buffer;
+		_buffer = nullptr;
+	}
+
+	void AddExportRow(ExportBuffer* _buffer, const ExportRow* _row)
+	{
+		for (auto column = 0; column < TOTAL_EXPORT_COLUMNS; column++)
+		{
+			_buffer->m_columns[column][_buffer->m_rows] = _row->m_values[column];
+		}
+
+		_buffer->m_rows++;
+		if (_buffer->m_rows == c_exportBlockRows)
+		{
+			FlushExportBuffer(_buffer);
+		}
+	}
+
+	/// <summary>
+	/// Write a buffer's rows out as text, one line per row.
+	/// </summary>
+	static void WriteCsvBlock(const ExportBuffer* _buffer)
+	{
+		auto* file = _buffer->m_writer->m_file;
+
+		auto failed = false;
+		for (auto row = 0; row < _buffer->m_rows; row++)
+		{
+			for (auto column = 0; column < TOTAL_EXPORT_COLUMNS; column++)
+			{
+				failed |= fprintf(file, column == 0 ? "%lld" : ",%lld", _buffer->m_columns[column][row]) < 0;
+			}
+			failed |= fprintf(file, "\n") < 0;
+		}
+
+		_buffer->m_writer->m_failed |= failed;
+	}
+
+	/// <summary>
+	/// Write a buffer's rows out as one columnar block, narrowing every column down to its width.
+	/// </summary>
+	static void WriteColumnBlock(ExportBuffer* _buffer)
+	{
+		auto* file = _buffer->m_writer->m_file;
+
+		ExportBlockHeader header{};
+		header.m_rows = _buffer->m_rows;
+
+		for (auto column = 0; column < TOTAL_EXPORT_COLUMNS; column++)
+		{
+			header.m_min[column] = _buffer->m_columns[column][0];
+			header.m_max[column] = _buffer->m_columns[column][0];
+
+			for (auto row = 1; row < _buffer->m_rows; row++)
+			{
+				const auto value = _buffer->m_columns[column][row];
+				header.m_min[column] = value < header.m_min[column] ? value : header.m_min[column];
+				header.m_max[column] = value > header.m_max[column] ? value : header.m_max[column];
+			}
+		}
+
+		auto failed = fwrite(&header, sizeof(header), 1, file) != 1;
+
+		for (auto column = 0; column < TOTAL_EXPORT_COLUMNS; column++)
+		{
+			const auto width = c_exportColumnWidths[column];
+
+			// The low bytes of a little-endian integer are the first ones in memory, so narrowing is just a partial copy.
+			for (auto row = 0; row < _buffer->m_rows; row++)
+			{
+				memcpy(&_buffer->m_scratch[row * width], &_buffer->m_columns[column][row], width);
+			}
+
+			// Pad the column out to a multiple of 8 bytes, so the next one starts aligned.
+			auto size = _buffer->m_rows * width;
+			while (size % 8 != 0)
+			{
+				_buffer->m_scratch[size++] = 0;
+			}
+
+			failed |= fwrite(_buffer->m_scratch, 1, size, file) != (size_t)size;
+		}
+
+		_buffer->m_writer->m_failed |= failed;
+	}
+
+	void FlushExportBuffer(ExportBuffer* _buffer)
+	{
+		if (_buffer->m_rows == 0)
+		{
+			return;
+		}
+
+		// The file is shared between threads, so only one block can be written at a time. That lock also guards the writer's failure flag.
+		{
+			std::lock_guard<std::mutex> lock(_buffer->m_writer->m_lock);
+
+			if (_buffer->m_writer->m_format == EXPORT_FORMAT_CSV)
+			{
+				WriteCsvBlock(_buffer);
+			}
+			else
+			{
+				WriteColumnBlock(_buffer);
+			}
+		}
+
+		_buffer->m_rows = 0;
+	}
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#ifndef EXPORT_H_
+#define EXPORT_H_
+
+#include <cstdio>
+#include <mutex>
+
+namespace blackjack
+{
+	/// <summary>
+	/// Every format simulation results can be exported in.<br>
+	/// Includes a value to refer to for the total amount of formats, which should not be assigned to a writer ever.
+	/// </summary>
+	enum eExportFormat : int
+	{
+		EXPORT_FORMAT_NONE = 0,
+		EXPORT_FORMAT_COLUMNS,
+		EXPORT_FORMAT_CSV,
+		TOTAL_EXPORT_FORMATS
+	};
+
+	/// <summary>
+	/// Every column written for each round.<br>
+	/// Includes a value to refer to for the total amount of columns, which should not be used as a column ever.
+	/// </summary>
+	enum eExportColumn : int
+	{
+		EXPORT_COLUMN_SESSION = 0,
+		EXPORT_COLUMN_BET,
+		EXPORT_COLUMN_OUTCOME,
+		EXPORT_COLUMN_PLAYER_TOTAL,
+		EXPORT_COLUMN_DEALER_TOTAL,
+		EXPORT_COLUMN_UPCARD,
+		EXPORT_COLUMN_BANK,
+		TOTAL_EXPORT_COLUMNS
+	};
+
+	/// <summary>
+	/// The size in bytes of every value in each column. Every column is a fixed-width little-endian signed integer.
+	/// </summary>
+	constexpr int c_exportColumnWidths[] = { 8, 4, 1, 1, 1, 1, 4, 0 };
+
+	/// <summary>
+	/// String values for every column name, used for the CSV header.
+	/// </summary>
+	constexpr char c_exportColumnNames[][13] = { "session", "bet", "outcome", "player_total", "dealer_total", "upcard", "bank", "" };
+
+	/// <summary>
+	/// The default file name for each format, written to the working directory.
+	/// </summary>
+	constexpr char c_exportFileNames[][11] = { "", "rounds.bjc", "rounds.csv", "" };
+
+	/// <summary>
+	/// The amount of rows buffered before they are written out as one block. Also the most rows a block can hold.
+	/// </summary>
+	constexpr auto c_exportBlockRows = 65536;
+
+	/// <summary>
+	/// The identifier at the very start of every columnar file.
+	/// </summary>
+	constexpr char c_exportMagic[8] = { 'B', 'J', 'C', 'O', 'L', 'S', '1', 0 };
+
+	/// <summary>
+	/// The header at the very start of every columnar file.<br>
+	/// After it come any number of blocks, each made of an ExportBlockHeader and then every column's values in order.
+	/// Each column is padded to a multiple of 8 bytes, so that every column of a memory-mapped file is 8-byte aligned.
+	/// </summary>
+	struct ExportFileHeader
+	{
+		char m_magic[8];
+		int m_version;
+		int m_columnCount;
+		int m_columnWidths[TOTAL_EXPORT_COLUMNS];
+		int m_padding;
+	};
+
+	/// <summary>
+	/// The header at the start of every block. The minimum and maximum of every column allow whole blocks to be skipped by a query.
+	/// </summary>
+	struct ExportBlockHeader
+	{
+		int m_rows;
+		int m_padding;
+		long long m_min[TOTAL_EXPORT_COLUMNS];
+		long long m_max[TOTAL_EXPORT_COLUMNS];
+	};
+
+	/// <summary>
+	/// Every value written for a single round, before it's split into columns.
+	/// </summary>
+	struct ExportRow
+	{
+		long long m_values[TOTAL_EXPORT_COLUMNS];
+	};
+
+	/// <summary>
+	/// A file that results are exported to. Shared between every thread writing to it.
+	/// </summary>
+	struct ExportWriter
+	{
+		FILE* m_file;
+		eExportFormat m_format;
+
+		/// <summary>
+		/// Set if anything couldn't be written, such as when the disk is full. The file is incomplete if so, even though its header looks fine.
+		/// </summary>
+		bool m_failed;
+
+		/// <summary>
+		/// Locked whenever a block is written, so that blocks from different threads never interleave.
+		/// </summary>
+		std::mutex m_lock;
+	};
+
+	/// <summary>
+	/// One thread's block of rows, which are kept in memory until the block is full. Every thread MUST have its own.
+	/// </summary>
+	struct ExportBuffer
+	{
+		ExportWriter* m_writer;
+		int m_rows;
+
+		/// <summary>
+		/// Every column's values, stored column by column. Values are only narrowed to their column's width once written.
+		/// </summary>
+		long long m_columns[TOTAL_EXPORT_COLUMNS][c_exportBlockRows];
+
+		/// <summary>
+		/// Space for one column narrowed down to its width, ready to be written.
+		/// </summary>
+		unsigned char m_scratch[c_exportBlockRows * sizeof(long long)];
+	};
+
+	/// <summary>
+	/// Allocate memory to and create a new writer in the heap, opening its file and writing the file's header.
+	/// </summary>
+	/// <param name="_path">The file to write to. Anything already in it is overwritten.</param>
+	/// <param name="_format">The format to write in. MUST NOT be EXPORT_FORMAT_NONE.</param>
+	/// <returns>A pointer to the created writer in memory, or nullptr if the file couldn't be opened.</returns>
+	ExportWriter* CreateExportWriter(const char _path[], eExportFormat _format);
+
+	/// <summary>
+	/// Close a writer's file, then free the memory allocated to it and nullify its pointer.<br>
+	/// Every buffer writing to it MUST have been destroyed first, or their rows will be lost.
+	/// </summary>
+	/// <param name="_writer">The writer to be de-allocated.</param>
+	/// <returns>False if anything couldn't be written, or the file couldn't be closed. The file is incomplete if so.</returns>
+	bool DestroyExportWriter(ExportWriter*& _writer);
+
+	/// <summary>
+	/// Allocate memory to and create a new, empty buffer in the heap.
+	/// </summary>
+	/// <param name="_writer">The writer the buffer's blocks will be written to.</param>
+	/// <returns>A pointer to the created buffer in memory.</returns>
+	ExportBuffer* CreateExportBuffer(ExportWriter* _writer);
+
+	/// <summary>
+	/// Write out anything left in a buffer, then free the memory allocated to it and nullify its pointer.
+	/// </summary>
+	/// <param name="_buffer">The buffer to be de-allocated.</param>
+	void DestroyExportBuffer(ExportBuffer*& _buffer);
+
+	/// <summary>
+	/// Add a row to a buffer, writing out the whole block if this fills it.
+	/// </summary>
+	/// <param name="_buffer">The buffer to add the row to.</param>
+	/// <param name="_row">The row to be added.</param>
+	void AddExportRow(ExportBuffer* _buffer, const ExportRow* _row);
+
+	/// <summary>
+	/// Write every row in a buffer out to its writer's file as one block, and empty the buffer.
+	/// </summary>
+	/// <param name="_buffer">The buffer to be written.</param>
+	void FlushExportBuffer(ExportBuffer* _buffer);
+}
+
+#endif
@@ -1,267 +1,715 @@
 #include "Game.h"
 
+#include <cstdio>
 #include <iostream>
 #include <iomanip>
 
+#include "AllocationTracker.h"
 #include "IO.h"
+#include "ShoeLibrary.h"
+#include "SolutionCache.h"
+#include "Strategy.h"
+#include "Trace.h"
+#include "Tracepoints.h"
 
 namespace blackjack
 {
 	Game* InitGame(const bool _debug)
 	{
+		return InitGame(_debug, 1, true);
+	}
+
+	/// <summary>
+	/// Shuffle every undealt card in the game's shoe, with swaps generated all at once by the game's batch generator.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	static void ShuffleUndealt(Game* _game)
+	{
+		unsigned short swaps[c_maxShoeSize];
+		GenerateShuffleSwaps(&_game->m_shuffleRandom, swaps, GetUndealtSize(_game->m_shoe));
+		ShuffleShoe(_game->m_shoe, swaps);
+	}
+
+	Game* InitGame(const bool _debug, const int _decks, const bool _backgroundShuffle)
+	{
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_INIT_GAME);
+
 		auto* dealer = CreatePlayer(0);
 		auto* player = CreatePlayer(c_startingBank);
-		auto* game = new Game{{dealer, player}, 0, {}, {}, 1, _debug };
+		auto* game = new Game{{dealer, player}, 0, {}, {}, nullptr, {}, {}, 1, _debug, GAME_STATE_FINISHED, &std::cout, true, nullptr, nullptr, 0 };
 
-		game->m_deck = GenerateDeck();
-		game->m_discard = GenerateDeck();
+		// The game's generators are seeded from rand(), so that they still follow the seed set in main.
+		SeedRandom(&game->m_random, (unsigned long long)rand() << 32 | (unsigned long long)rand());
+		if (_backgroundShuffle)
+		{
+			game->m_shuffler = CreateShufflePipeline(NextRandom(&game->m_random));
+		}
+		SeedBatchRandom(&game->m_shuffleRandom, NextRandom(&game->m_random));
 
-		// The actual deck is populated at the start of the game. No other deck should be!
-		// There will never be any issues with too many cards in any one deck as long as only this deck is populated at the start.
-		PopulateDeck(game->m_deck);
+		game->m_shoe = GenerateShoe();
+		PopulateShoe(game->m_shoe, _decks);
+		ShuffleUndealt(game);
 
-		ShuffleDeck(game->m_deck);
+		// Only Debug Mode gives advice. If the cache can't be written to (or opened at all), the advice is simply solved every time.
+		if (_debug)
+		{
+			game->m_solutions = OpenSolutionCache(c_solutionCacheFileName, true);
+			if (game->m_solutions == nullptr)
+			{
+				game->m_solutions = OpenSolutionCache(c_solutionCacheFileName, false);
+			}
+		}
 
+		END_ALLOCATION_SCOPE();
 		return game;
 	}
 
+	void ResetGame(Game* _game, const unsigned long long _seed)
+	{
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_RESET_GAME);
+
+		SeedRandom(&_game->m_random, _seed);
+		SeedBatchRandom(&_game->m_shuffleRandom, NextRandom(&_game->m_random));
+
+		for (auto playerIndex = 0; playerIndex < TOTAL_PLAYERS; playerIndex++)
+		{
+			ClearHand(&_game->m_players[playerIndex]->m_hand);
+		}
+
+		_game->m_players[PLAYER_DEALER]->m_bank = 0;
+		_game->m_players[PLAYER_PLAYER]->m_bank = c_startingBank;
+		_game->m_currentBet = 0;
+		for (auto sideBet = 0; sideBet < TOTAL_SIDE_BETS; sideBet++)
+		{
+			_game->m_sideBets[sideBet] = 0;
+		}
+		_game->m_aceValue = 1;
+		_game->m_state = GAME_STATE_FINISHED;
+
+		// A recorded ordering is dealt exactly as it is. Otherwise, re-populating the shoe puts every card back in order, so it has to be shuffled again.
+		if (_game->m_shoeLibrary != nullptr)
+		{
+			PopulateShoeInOrder(_game->m_shoe, GetLibraryShoe(_game->m_shoeLibrary, _game->m_nextLibraryShoe++), _game->m_shoe->m_size / c_maxDeckSize);
+		}
+		else
+		{
+			PopulateShoe(_game->m_shoe, _game->m_shoe->m_size / c_maxDeckSize);
+			ShuffleUndealt(_game);
+		}
+
+		END_ALLOCATION_SCOPE();
+	}
+
+	void SetShoeLibrary(Game* _game, const ShoeLibrary* _library, const long long _firstShoe)
+	{
+		_game->m_shoeLibrary = _library;
+		_game->m_nextLibraryShoe = _firstShoe;
+	}
+
 	void EndGame(Game*& _game)
 	{
-		// The deck, discard pile, and every player must all be de-allocated before the game.
-		// Failing to remember to do this could cause memory leaks.
-		DestroyDeck(_game->m_deck);
-		DestroyDeck(_game->m_discard);
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_END_GAME);
 
+		// Hands hold copies of the cards they were dealt, so the players and shoe can be de-allocated in any order.
+		// The shoe, pipeline, and every player must all be de-allocated before the game, or this will cause memory leaks.
 		for (auto playerIndex = 0; playerIndex < TOTAL_PLAYERS; playerIndex++)
 		{
 			DestroyPlayer(_game->m_players[playerIndex]);
 		}
 
+		DestroyShoe(_game->m_shoe);
+		if (_game->m_shuffler != nullptr)
+		{
+			DestroyShufflePipeline(_game->m_shuffler);
+		}
+		if (_game->m_solutions != nullptr)
+		{
+			CloseSolutionCache(_game->m_solutions);
+		}
+
 		delete _game;
 		_game = nullptr;
+
+		END_ALLOCATION_SCOPE();
 	}
 
-	void GameLoop(Game* _game)
+	/// <summary>
+	/// Clear everything that has been displayed so far.<br>
+	/// std::flush forces the console to sync up with the output stream, which is necessary for calls to system.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	static void ClearScreen(Game* _game)
 	{
-		// The game will loop infinitely until either the player runs out of money or they choose to stop playing.
-		// When done, the function will resolve, where the menu will then delete the game instance and loop.
-		auto playing = true;
-		while (playing)
+		if (_game->m_console)
+		{
+			*_game->m_output << std::flush;
+			system("CLS");
+		}
+		else
+		{
+			// Anything that isn't the console is most likely a terminal on the other end of something, which understands this instead.
+			*_game->m_output << "\x1B[2J\x1B[H";
+		}
+	}
+
+	/// <summary>
+	/// Display what basic strategy would do, and the expected result of hitting and of standing, for the player's hand against the dealer's face-up card.<br>
+	/// The player hasn't seen the hole card, so it counts as one of the cards that could still be drawn.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	static void DisplayAdvice(Game* _game)
+	{
+		// Two aces worth 11 are dealt as 22, which is already bust. There's nothing to advise then.
+		const auto total = GetTotalHandValue(_game->m_players[PLAYER_PLAYER], _game->m_aceValue);
+		if (total >= c_solvedTotals)
 		{
-			SelectBet(_game);
-			SelectAceValue(_game);
+			return;
+		}
+
+		const auto* dealerHand = &_game->m_players[PLAYER_DEALER]->m_hand;
+
+		Composition composition;
+		GetShoeComposition(_game->m_shoe, &composition);
+		composition.m_counts[GetValueClass(dealerHand->m_cards[0].m_rank)]++;
+
+		CompositionSolution solution;
+		GetSolution(_game->m_solutions, &composition, _game->m_aceValue, &solution);
+
+		const auto upcard = GetValueClass(dealerHand->m_cards[1].m_rank);
+		const auto action = GetBasicStrategy(_game->m_aceValue)->m_actions[total][upcard];
+
+		char advice[96];
+		sprintf_s(advice, "Basic Strategy: %s, Expected Result: Hit %+.3f, Stand %+.3f\n", action == PLAYER_ACTION_HIT ? "Hit" : "Stand",
+			solution.m_hitValues[total][upcard], solution.m_standValues[total][upcard]);
+		*_game->m_output << advice;
+	}
 
-			InitialDeal(_game);
-			PlayerTurn(_game);
-			DealerTurn(_game);
+	/// <summary>
+	/// Move the game to a new state, displaying whatever the player needs to see before giving their input.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	/// <param name="_state">The state to wait in.</param>
+	static void SetGameState(Game* _game, const eGameState _state)
+	{
+		_game->m_state = _state;
 
-			ComparePlayers(_game);
+		switch (_state)
+		{
+			case GAME_STATE_SELECT_BET:
+			{
+				ClearScreen(_game);
+				*_game->m_output << "How much do you want to bet? (Current Money: \x9C" << _game->m_players[PLAYER_PLAYER]->m_bank << ")\n";
+				break;
+			}
 
-			DiscardHands(_game);
+			case GAME_STATE_SELECT_ACE_VALUE:
+			{
+				*_game->m_output << "How much do you want aces to be worth?\nOptions:\n(1) - Aces are worth 1\n(2) - Aces are worth 11\n";
+				break;
+			}
 
-			// If the player goes bankrupt, they automatically lose the game and are returned to the menu.
-			if (_game->m_players[PLAYER_PLAYER]->m_bank < 1)
+			case GAME_STATE_PLAYER_TURN:
 			{
-				playing = false;
+				if (_game->m_debug)
+				{
+					DisplayAdvice(_game);
+				}
+				*_game->m_output << "Options:\n(1) - Hit (Ask for another card)\n(2) - Stand (Keep current hand)\n";
+				break;
+			}
 
-				// The screen is paused until the player enters a key, so that they know what's happened.
-				// std::flush forces the console to sync up with the output stream, which is necessary for calls to system.
-				// I'm obviously oversimplifying a lot, but this is a comment in my program, not cppreference.
-				std::cout << "You are bankrupt! Returning to menu...\n\n" << std::flush;
-				system("PAUSE");
+			case GAME_STATE_PLAYER_BUST:
+			{
+				// The player gets to see that their hand is bust before the dealer's turn is displayed.
+				*_game->m_output << "Player's hand is bust! (Over 21)\n";
+				break;
 			}
-			else if(!EndOfRound())
+
+			case GAME_STATE_BANKRUPT:
 			{
-				playing = false;
+				*_game->m_output << "You are bankrupt! Returning to menu...\n\n";
+				break;
+			}
+
+			case GAME_STATE_END_OF_ROUND:
+			{
+				*_game->m_output << "Do you wish to continue playing?\n(1) - Yes\n(2) - No\n";
+				break;
+			}
+
+			default:
+			{
+				// The round result is displayed by ComparePlayers, and a finished game has nothing left to say.
+				break;
 			}
 		}
 	}
 
-	void SelectBet(Game* _game)
+	/// <summary>
+	/// The dealer takes their turn, and the hands are compared. The game then waits for the player to see the result.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	static void FinishRound(Game* _game)
+	{
+		DealerTurn(_game);
+		ComparePlayers(_game);
+
+		SetGameState(_game, GAME_STATE_ROUND_RESULT);
+	}
+
+	void GameLoop(Game* _game)
 	{
-		const auto currentMoney = _game->m_players[PLAYER_PLAYER]->m_bank;
+		GameLoop(_game, nullptr);
+	}
+
+	void GameLoop(Game* _game, InputTrace* o_trace)
+	{
+		// The game will loop infinitely until either the player runs out of money or they choose to stop playing.
+		// When done, the function will resolve, where the menu will then delete the game instance and loop.
+		// Every input is read here, so the game itself never has to wait on std::cin.
+		StartGame(_game);
+		while (_game->m_state != GAME_STATE_FINISHED)
+		{
+			auto input = 0;
+			switch (_game->m_state)
+			{
+				case GAME_STATE_SELECT_BET:
+				{
+					// The player can obviously only bet an amount of money they actually have!
+					input = GetBet(GetInputMax(_game));
+					break;
+				}
 
-		system("CLS");
-		std::cout << "How much do you want to bet? (Current Money: \x9C" << currentMoney << ")\n";
+				case GAME_STATE_PLAYER_BUST:
+				case GAME_STATE_ROUND_RESULT:
+				case GAME_STATE_BANKRUPT:
+				{
+					// The screen is paused until the player enters a key, so that they know what's happened.
+					*_game->m_output << std::flush;
+					system("PAUSE");
+					break;
+				}
 
-		// The player can obviously only bet an amount of money they actually have!
-		const auto bet = GetBet(currentMoney);
+				default:
+				{
+					input = GetOption(GetInputMax(_game));
+					break;
+				}
+			}
 
-		_game->m_players[PLAYER_PLAYER]->m_bank -= bet;
-		_game->m_currentBet = bet;
+			// Pauses are recorded too, so that a replay gives the game exactly the same inputs in exactly the same order.
+			if (o_trace != nullptr)
+			{
+				RecordInput(o_trace, input);
+			}
 
-		std::cout << "\n";
+			AdvanceGame(_game, input);
+		}
 	}
 
-	void SelectAceValue(Game* _game)
+	void StartGame(Game* _game)
 	{
-		std::cout << "How much do you want aces to be worth?\nOptions:\n(1) - Aces are worth 1\n(2) - Aces are worth 11\n";
+		SetGameState(_game, GAME_STATE_SELECT_BET);
+	}
 
-		// Change the input value to 0 or 1, then multiply by 10 and add 1.
-		// (1): 1 - 1 = 0, 0 * 10 = 0, 0 + 1 = 1
-		// (2): 2 - 1 = 1, 1 * 10 = 10, 10 + 1 = 11
-		_game->m_aceValue = (GetOption(2) - 1) * 10 + 1;
+	void AdvanceGame(Game* _game, const int _input)
+	{
+		switch (_game->m_state)
+		{
+			case GAME_STATE_SELECT_BET:
+			{
+				SelectBet(_game, _input);
+				break;
+			}
+
+			case GAME_STATE_SELECT_ACE_VALUE:
+			{
+				SelectAceValue(_game, _input);
+				break;
+			}
+
+			case GAME_STATE_PLAYER_TURN:
+			{
+				PlayerTurn(_game, _input);
+				break;
+			}
+
+			case GAME_STATE_PLAYER_BUST:
+			{
+				// A bust hand passes straight to the dealer, as there's nothing else the player can do.
+				FinishRound(_game);
+				break;
+			}
+
+			case GAME_STATE_ROUND_RESULT:
+			{
+				DiscardHands(_game);
+
+				// If the player goes bankrupt, they automatically lose the game and are returned to the menu.
+				SetGameState(_game, _game->m_players[PLAYER_PLAYER]->m_bank < 1 ? GAME_STATE_BANKRUPT : GAME_STATE_END_OF_ROUND);
+				break;
+			}
+
+			case GAME_STATE_BANKRUPT:
+			{
+				SetGameState(_game, GAME_STATE_FINISHED);
+				break;
+			}
+
+			case GAME_STATE_END_OF_ROUND:
+			{
+				EndOfRound(_game, _input);
+				break;
+			}
+
+			default:
+			{
+				// A finished game doesn't take any more input.
+				break;
+			}
+		}
 	}
 
-	void InitialDeal(Game* _game)
+	int GetInputMax(const Game* _game)
 	{
-		for (auto i = 0; i < c_initialDeal; i++)
+		switch (_game->m_state)
 		{
-			for (auto playerIndex = 0; playerIndex < TOTAL_PLAYERS; playerIndex++)
+			case GAME_STATE_SELECT_BET:
+			{
+				return _game->m_players[PLAYER_PLAYER]->m_bank;
+			}
+
+			case GAME_STATE_SELECT_ACE_VALUE:
+			case GAME_STATE_PLAYER_TURN:
+			case GAME_STATE_END_OF_ROUND:
+			{
+				return 2;
+			}
+
+			default:
 			{
-				DealCard(_game, _game->m_players[playerIndex]->m_hand);
+				return 0;
 			}
 		}
+	}
 
-		if (!_game->m_debug)
+	void DisplayGamePrompt(Game* _game)
+	{
+		switch (_game->m_state)
 		{
-			_game->m_players[PLAYER_DEALER]->m_hand->m_cards[0]->m_visible = false;
+			case GAME_STATE_SELECT_BET:
+			{
+				DisplayInputPrompt(*_game->m_output, GetInputMax(_game), "a value", "\x9C", "", "\x9C");
+				break;
+			}
+
+			case GAME_STATE_PLAYER_BUST:
+			case GAME_STATE_ROUND_RESULT:
+			case GAME_STATE_BANKRUPT:
+			{
+				*_game->m_output << "Press enter to continue . . . ";
+				break;
+			}
+
+			case GAME_STATE_FINISHED:
+			{
+				break;
+			}
+
+			default:
+			{
+				DisplayInputPrompt(*_game->m_output, GetInputMax(_game), "an option", "(", ")", "");
+				break;
+			}
 		}
+	}
+
+	void SelectBet(Game* _game, const int _bet)
+	{
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_BET);
+
+		_game->m_players[PLAYER_PLAYER]->m_bank -= _bet;
+		_game->m_currentBet = _bet;
+
+		*_game->m_output << "\n";
+
+		SetGameState(_game, GAME_STATE_SELECT_ACE_VALUE);
+
+		END_ALLOCATION_SCOPE();
+	}
+
+	void SelectAceValue(Game* _game, const int _option)
+	{
+		// Change the input value to 0 or 1, then multiply by 10 and add 1.
+		// (1): 1 - 1 = 0, 0 * 10 = 0, 0 + 1 = 1
+		// (2): 2 - 1 = 1, 1 * 10 = 10, 10 + 1 = 11
+		_game->m_aceValue = (_option - 1) * 10 + 1;
+
+		InitialDeal(_game);
+		SetGameState(_game, GAME_STATE_PLAYER_TURN);
+	}
+
+	void InitialDeal(Game* _game)
+	{
+		DealInitialHands(_game);
 
-		system("CLS");
-		std::cout << "Initial Draw..." << std::endl << std::endl;
+		ClearScreen(_game);
+		*_game->m_output << "Initial Draw..." << std::endl << std::endl;
 		DisplayGameInformation(_game);
 	}
 
-	void PlayerTurn(Game* _game)
+	void PlayerTurn(Game* _game, const int _option)
 	{
-		auto isPlayerTurn = true;
-		while (isPlayerTurn)
-		{
-			std::cout << "Options:\n(1) - Hit (Ask for another card)\n(2) - Stand (Keep current hand)\n";
-			const auto playerInput = GetOption(2);
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_PLAYER_TURN);
 
-			switch(playerInput)
+		switch(_option)
+		{
+			case 1:
 			{
-				case 1:
-				{
-					system("CLS");
-					std::cout << "Player Draws...\n\n";
-
-					DealCard(_game, _game->m_players[PLAYER_PLAYER]->m_hand);
-					DisplayGameInformation(_game);
-
-					// If the player's hand is bust, then they automatically pass their turn to the dealer as there's nothing else they can do.
-					const auto totalHandValue = GetTotalHandValue(_game->m_players[PLAYER_PLAYER], _game->m_aceValue);
-					if (totalHandValue > 21)
-					{
-						// Pause the console until the player enters a key, so they know that their hand is bust.
-						std::cout << "Player's hand is bust! (Over 21)\n" << std::flush;
-						system("PAUSE");
-						isPlayerTurn = false;
-					}
+				ClearScreen(_game);
+				*_game->m_output << "Player Draws...\n\n";
 
-					break;
-				}
-				case 2:
-				{
-					// The player is happy with their hand and passes to the dealer, breaking the while loop.
-					isPlayerTurn = false;
+				DealCard(_game, &_game->m_players[PLAYER_PLAYER]->m_hand);
+				DisplayGameInformation(_game);
 
-					break;
-				}
-				default:
-				{
-					// The IO code should automatically prevent other options from being selected but it's good to catch errors.
-					std::cout << "Unexpected player option case encountered!\n\n";
+				// If the player's hand is bust, then they automatically pass their turn to the dealer once they've seen it.
+				// Otherwise, they get to choose again.
+				const auto totalHandValue = GetTotalHandValue(_game->m_players[PLAYER_PLAYER], _game->m_aceValue);
+				SetGameState(_game, totalHandValue > 21 ? GAME_STATE_PLAYER_BUST : GAME_STATE_PLAYER_TURN);
+
+				break;
+			}
+			case 2:
+			{
+				// The player is happy with their hand and passes to the dealer.
+				FinishRound(_game);
+
+				break;
+			}
+			default:
+			{
+				// The IO code should automatically prevent other options from being selected but it's good to catch errors.
+				*_game->m_output << "Unexpected player option case encountered!\n\n";
+				SetGameState(_game, GAME_STATE_PLAYER_TURN);
 						
-					break;
-				}
+				break;
 			}
 		}
+
+		END_ALLOCATION_SCOPE();
 	}
 
 	void DealerTurn(Game* _game)
 	{
-		// Flip dealer's first card face up
-		if (!_game->m_debug)
-		{
-			_game->m_players[PLAYER_DEALER]->m_hand->m_cards[0]->m_visible = true;
-		}
-
-		while (GetTotalHandValue(_game->m_players[PLAYER_DEALER], _game->m_aceValue) < 17)
-		{
-			DealCard(_game, _game->m_players[PLAYER_DEALER]->m_hand);
-		}
+		PlayDealerHand(_game);
 
-		system("CLS");
-		std::cout << "Dealer Draws...\n\n";
+		ClearScreen(_game);
+		*_game->m_output << "Dealer Draws...\n\n";
 
 		DisplayGameInformation(_game);
 	}
 
 	void ComparePlayers(Game* _game)
 	{
-		switch (CompareHands(_game->m_players[PLAYER_PLAYER], _game->m_players[PLAYER_DEALER], _game->m_aceValue))
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_SETTLE);
+
+		const auto result = CompareHands(_game->m_players[PLAYER_PLAYER], _game->m_players[PLAYER_DEALER], _game->m_aceValue);
+		const auto payout = GetPayout(result, _game->m_currentBet);
+		TRACEPOINT_PAYOUT(result, _game->m_currentBet, payout, GetTotalHandValue(_game->m_players[PLAYER_PLAYER], _game->m_aceValue),
+			GetTotalHandValue(_game->m_players[PLAYER_DEALER], _game->m_aceValue));
+
+		switch (result)
 		{
 		case HAND_COMPARISON_LOSS:
 			{
-				std::cout << "Dealer Wins!\nYou lose your bet (\x9C" << _game->m_currentBet << ")...\n";
-				
-				_game->m_currentBet = 0;
+				*_game->m_output << "Dealer Wins!\nYou lose your bet (\x9C" << _game->m_currentBet << ")...\n";
 				break;
 			}
 
 		case HAND_COMPARISON_TIE:
 			{
-				std::cout << "Player Ties!\nYou receive your bet (\x9C" << _game->m_currentBet << ") back.\n";
-				
-				_game->m_players[PLAYER_PLAYER]->m_bank += _game->m_currentBet;
-				_game->m_currentBet = 0;
+				*_game->m_output << "Player Ties!\nYou receive your bet (\x9C" << _game->m_currentBet << ") back.\n";
 				break;
 			}
 
 		case HAND_COMPARISON_WIN:
 			{
-				std::cout << "Player Wins!\nYou receive double your initial bet, earning \x9C" << _game->m_currentBet * 2 <<
-					" back!\n";
-				
-				_game->m_players[PLAYER_PLAYER]->m_bank += _game->m_currentBet * 2;
-				_game->m_currentBet = 0;
+				*_game->m_output << "Player Wins!\nYou receive double your initial bet, earning \x9C" << payout << " back!\n";
 				break;
 			}
 
 		case HAND_COMPARISON_NATURAL:
 			{
-				std::cout << "...BLACKJACK!!!\nYou receive two and a half times your initial bet, earning \x9C" << 
-					(int)((float)_game->m_currentBet * 2.5f) << " back!\n";
-				
-				_game->m_players[PLAYER_PLAYER]->m_bank += (int)((float)_game->m_currentBet * 2.5f);
-				_game->m_currentBet = 0;
+				*_game->m_output << "...BLACKJACK!!!\nYou receive two and a half times your initial bet, earning \x9C" << payout << " back!\n";
 				break;
 			}
 		}
 
-		std::cout << "\n" << std::flush;
-		system("PAUSE");
+		_game->m_players[PLAYER_PLAYER]->m_bank += payout;
+		_game->m_currentBet = 0;
+
+		*_game->m_output << "\n";
+
+		END_ALLOCATION_SCOPE();
 	}
 
 	void DiscardHands(Game* _game)
 	{
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_SETTLE);
+
 		for (auto playerIndex = 0; playerIndex < TOTAL_PLAYERS; playerIndex++)
 		{
-			MergeDecks(_game->m_players[playerIndex]->m_hand, _game->m_discard);
+			ClearHand(&_game->m_players[playerIndex]->m_hand);
+		}
+
+		// Every card in play is in one of the hands, so they can all be discarded at once.
+		DiscardInPlay(_game->m_shoe);
+
+		END_ALLOCATION_SCOPE();
+	}
+
+	void DealInitialHands(Game* _game)
+	{
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_DEAL);
+
+		for (auto i = 0; i < c_initialDeal; i++)
+		{
+			for (auto playerIndex = 0; playerIndex < TOTAL_PLAYERS; playerIndex++)
+			{
+				DealCard(_game, &_game->m_players[playerIndex]->m_hand);
+			}
+		}
+
+		if (!_game->m_debug)
+		{
+			_game->m_players[PLAYER_DEALER]->m_hand.m_cards[0].m_visible = false;
+		}
+
+		END_ALLOCATION_SCOPE();
+	}
+
+	void PlayDealerHand(Game* _game)
+	{
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_DEALER_TURN);
+
+		// Flip dealer's first card face up
+		if (!_game->m_debug)
+		{
+			_game->m_players[PLAYER_DEALER]->m_hand.m_cards[0].m_visible = true;
+		}
+
+		// The dealer stands well before their hand is full, but the loop is bounded anyway so that it can never spin on a card that wasn't added.
+		auto* dealerHand = &_game->m_players[PLAYER_DEALER]->m_hand;
+		while (GetTotalHandValue(_game->m_players[PLAYER_DEALER], _game->m_aceValue) < c_dealerStandValue && dealerHand->m_size < c_maxHandSize)
+		{
+			DealCard(_game, dealerHand);
+		}
+
+		// Both the game's dealer turn and the simulation's end here, so this covers every dealer hand.
+		TRACEPOINT_DEALER_TURN(GetTotalHandValue(_game->m_players[PLAYER_DEALER], _game->m_aceValue), _game->m_players[PLAYER_DEALER]->m_hand.m_size);
+
+		END_ALLOCATION_SCOPE();
+	}
+
+	int GetPayout(const eHandValidityComparison _result, const int _bet)
+	{
+		switch (_result)
+		{
+			case HAND_COMPARISON_TIE:
+			{
+				return _bet;
+			}
+
+			case HAND_COMPARISON_WIN:
+			{
+				return _bet * 2;
+			}
+
+			case HAND_COMPARISON_NATURAL:
+			{
+				return (int)((float)_bet * 2.5f);
+			}
+
+			default:
+			{
+				return 0;
+			}
 		}
 	}
 
-	bool EndOfRound()
+	int SettleSideBets(Game* _game, eSideBetResult o_results[TOTAL_SIDE_BETS])
 	{
-		std::cout << "Do you wish to continue playing?\n(1) - Yes\n(2) - No\n";
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_SETTLE);
+
+		const auto* playerCards = _game->m_players[PLAYER_PLAYER]->m_hand.m_cards;
+		const auto upcard = _game->m_players[PLAYER_DEALER]->m_hand.m_cards[1];
 
-		// The brackets here are important, as otherwise the possible values would be -1 and -2, which we obviously don't want.
-		return 1 - (GetOption(2) - 1);
+		o_results[SIDE_BET_PERFECT_PAIRS] = GetPerfectPairsResult(playerCards[0], playerCards[1]);
+		o_results[SIDE_BET_TWENTY_ONE_PLUS_THREE] = GetTwentyOnePlusThreeResult(playerCards[0], playerCards[1], upcard);
+
+		auto payout = 0;
+		for (auto sideBet = 0; sideBet < TOTAL_SIDE_BETS; sideBet++)
+		{
+			// A side bet with nothing on it can't win anything, so its result is cleared rather than left to look like a win.
+			o_results[sideBet] = _game->m_sideBets[sideBet] > 0 ? o_results[sideBet] : SIDE_BET_RESULT_NONE;
+			payout += GetSideBetPayout(o_results[sideBet], _game->m_sideBets[sideBet]);
+			_game->m_sideBets[sideBet] = 0;
+		}
+
+		_game->m_players[PLAYER_PLAYER]->m_bank += payout;
+
+		END_ALLOCATION_SCOPE();
+		return payout;
 	}
 
+	void EndOfRound(Game* _game, const int _option)
+	{
+		SetGameState(_game, _option == 1 ? GAME_STATE_SELECT_BET : GAME_STATE_FINISHED);
+	}
 
-	void DealCard(Game* _game, Deck* _hand)
+
+	void DealCard(Game* _game, Hand* _hand)
 	{
-		MoveCard(_game->m_deck, _hand);
+		// A continuous shuffling machine has no discard pile to reshuffle, since discarded cards go straight back in.
+		if (_game->m_shoe->m_continuous)
+		{
+			const auto* card = DrawFromShoe(_game->m_shoe, &_game->m_random);
+			AddCard(_hand, card);
+			TRACEPOINT_DEAL_CARD(card, GetUndealtSize(_game->m_shoe), _game->m_shoe->m_runningCount);
+			return;
+		}
+
+		const auto* card = DealFromShoe(_game->m_shoe);
+		AddCard(_hand, card);
+		TRACEPOINT_DEAL_CARD(card, GetUndealtSize(_game->m_shoe), _game->m_shoe->m_runningCount);
 
-		// If the deck is empty, then shuffle the discard pile back into it.
-		if (_game->m_deck->m_size < 1)
+		// If the shoe is empty, then shuffle the discard pile back into it.
+		if (GetUndealtSize(_game->m_shoe) < 1)
 		{
-			MergeDecks(_game->m_discard, _game->m_deck);
-			ShuffleDeck(_game->m_deck);
+			// A recorded shoe never needs any swaps, since the next ordering says exactly where every card goes.
+			if (_game->m_shoeLibrary != nullptr)
+			{
+				TRACEPOINT_RESHUFFLE(_game->m_shoe->m_discardSize, "Library");
+				ReshuffleDiscardInOrder(_game->m_shoe, GetLibraryShoe(_game->m_shoeLibrary, _game->m_nextLibraryShoe++));
+				return;
+			}
+
+			// Usually the producer has swaps ready, and the discard pile can be shuffled without generating any random numbers.
+			// If it's fallen behind, generate the swaps here rather than waiting for it.
+			const auto* order = _game->m_shuffler != nullptr ? PeekShuffleOrder(_game->m_shuffler) : nullptr;
+			if (order != nullptr)
+			{
+				TRACEPOINT_RESHUFFLE(_game->m_shoe->m_discardSize, "Pipeline");
+				ReshuffleDiscard(_game->m_shoe, order->m_swaps);
+				ReleaseShuffleOrder(_game->m_shuffler);
+			}
+			else
+			{
+				TRACEPOINT_RESHUFFLE(_game->m_shoe->m_discardSize, "Generated");
+				unsigned short swaps[c_maxShoeSize];
+				GenerateShuffleSwaps(&_game->m_shuffleRandom, swaps, _game->m_shoe->m_discardSize);
+				ReshuffleDiscard(_game->m_shoe, swaps);
+			}
 		}
 	}
 
@@ -269,12 +717,12 @@ namespace blackjack
 	{
 		if(_game->m_debug)
 		{
-			std::cout << "DEBUG MODE\n";
+			*_game->m_output << "DEBUG MODE\n";
 		}
 
 		// \x9C is the Unicode character for the pound symbol. Not guaranteed to be the same on every system ever.
 		// ...but it should be standard amongst most systems.
-		std::cout << "Total Money: \x9C" << _game->m_players[PLAYER_PLAYER]->m_bank << " Current Bet: \x9C" << _game->
+		*_game->m_output << "Total Money: \x9C" << _game->m_players[PLAYER_PLAYER]->m_bank << " Current Bet: \x9C" << _game->
 			m_currentBet << "\n\n";
 
 		// A two dimensional array, double the potential length of the actual display.
@@ -288,7 +736,7 @@ namespace blackjack
 			strcat_s(cardDisplay[playerIndex], " Hand");
 
 			// The offset here is offset by TOTAL_PLAYERS, since there is an additional line at the top of each column for the player name.
-			DisplayHand(_game->m_players[playerIndex]->m_hand, _game->m_aceValue, cardDisplay, TOTAL_PLAYERS, playerIndex + TOTAL_PLAYERS);
+			DisplayHand(&_game->m_players[playerIndex]->m_hand, _game->m_aceValue, cardDisplay, TOTAL_PLAYERS, playerIndex + TOTAL_PLAYERS);
 		}
 
 		for (auto displayIndex = 0; displayIndex < c_maxDisplaySize; displayIndex++)
@@ -301,11 +749,11 @@ namespace blackjack
 			}
 
 			// Set the output to be padded, keeping text to the left, so that every column is neatly formatted.
-			std::cout << std::setw(c_maxDisplayLength + c_columnOffset) << std::left <<
+			*_game->m_output << std::setw(c_maxDisplayLength + c_columnOffset) << std::left <<
 				cardDisplay[displayIndex * TOTAL_PLAYERS] << cardDisplay[displayIndex * TOTAL_PLAYERS + 1] << "\n";
 		}
 
 		// One line break, just to neatly format the application.
-		std::cout << "\n";
+		*_game->m_output << "\n";
 	}
 }
@@ -3,11 +3,26 @@
 #ifndef GAME_H_
 #define GAME_H_
 
+#include <iosfwd>
+
 #include "Player.h"
-#include "Deck.h"
+#include "BatchRandom.h"
+#include "Pipeline.h"
+#include "Random.h"
+#include "Shoe.h"
+#include "SideBet.h"
 
 namespace blackjack
 {
+	// The solution cache's solver follows the game's rules, so it includes this header. The game only needs to point at a cache.
+	struct SolutionCache;
+
+	// Traces record the inputs given to a game, so they only need to be pointed at while it's played.
+	struct InputTrace;
+
+	// Libraries are mapped files of their own, so the game only needs to point at one while it deals from it.
+	struct ShoeLibrary;
+
 	/// <summary>
 	/// Whatever default money value the player should start at.
 	/// </summary>
@@ -18,11 +33,44 @@ namespace blackjack
 	/// </summary>
 	constexpr auto c_initialDeal = 2;
 
+	/// <summary>
+	/// The dealer keeps dealing themselves cards until their hand is valued at least this much.
+	/// </summary>
+	constexpr auto c_dealerStandValue = 17;
+
 	/// <summary>
 	/// A mandatory amount of padding to be applied when displaying columns in the menu.
 	/// </summary>
 	constexpr auto c_columnOffset = 10;
 
+	/// <summary>
+	/// Every decision the player can make on their turn, in the same order as the options in PlayerTurn.<br>
+	/// Includes a value to refer to for the total amount of actions, which should not be used as an action ever.
+	/// </summary>
+	enum ePlayerAction : int
+	{
+		PLAYER_ACTION_HIT = 0,
+		PLAYER_ACTION_STAND,
+		TOTAL_PLAYER_ACTIONS
+	};
+
+	/// <summary>
+	/// Every point in a round that the game can be waiting at. Each state, other than "GAME_STATE_FINISHED", is waiting for one input.<br>
+	/// Options and bets are from 1 to GetInputMax, and "pause" states only wait for the player to press any key (which is given as 0).
+	/// </summary>
+	enum eGameState : int
+	{
+		GAME_STATE_SELECT_BET = 0,
+		GAME_STATE_SELECT_ACE_VALUE,
+		GAME_STATE_PLAYER_TURN,
+		GAME_STATE_PLAYER_BUST,
+		GAME_STATE_ROUND_RESULT,
+		GAME_STATE_BANKRUPT,
+		GAME_STATE_END_OF_ROUND,
+		GAME_STATE_FINISHED,
+		TOTAL_GAME_STATES
+	};
+
 	struct Game
 	{
 		Player* m_players[(int)TOTAL_PLAYERS];
@@ -32,8 +80,30 @@ namespace blackjack
 		/// </summary>
 		int m_currentBet;
 
-		Deck* m_deck;
-		Deck* m_discard;
+		/// <summary>
+		/// The amount of money put on each side bet this round. Side bets are settled as soon as the initial hands have been dealt.
+		/// </summary>
+		int m_sideBets[TOTAL_SIDE_BETS];
+
+		/// <summary>
+		/// Every card in the game. Cards are copied from this into players' hands as they're dealt.
+		/// </summary>
+		Shoe* m_shoe;
+
+		/// <summary>
+		/// Shuffles orders in the background, so that running out of cards doesn't stall the deal to reshuffle.
+		/// </summary>
+		ShufflePipeline* m_shuffler;
+
+		/// <summary>
+		/// The game's own generator, used for seeding and for drawing from a continuous shoe.
+		/// </summary>
+		Random m_random;
+
+		/// <summary>
+		/// Generates swaps in bulk, for the first shuffle and for any reshuffle the pipeline isn't ready for.
+		/// </summary>
+		BatchRandom m_shuffleRandom;
 
 		/// <summary>
 		/// The integer value of Aces (should be 1 or 11)
@@ -44,6 +114,33 @@ namespace blackjack
 		/// Whether the game is running in Debug Mode. If this is true, "Hole Cards" will be displayed face-up.
 		/// </summary>
 		bool m_debug;
+
+		/// <summary>
+		/// Which input the game is currently waiting for.
+		/// </summary>
+		eGameState m_state;
+
+		/// <summary>
+		/// Where everything the game displays is written. This is std::cout unless something else is driving the game.
+		/// </summary>
+		std::ostream* m_output;
+
+		/// <summary>
+		/// Whether the output is the console, and can be cleared with "CLS". Otherwise, an escape code is written to the output instead.
+		/// </summary>
+		bool m_console;
+
+		/// <summary>
+		/// Solutions for the shoe's compositions, used to advise the player in Debug Mode. nullptr if there's no cache to use.
+		/// </summary>
+		SolutionCache* m_solutions;
+
+		/// <summary>
+		/// Recorded orderings to deal every shoe from, instead of shuffling. nullptr unless something sets one with SetShoeLibrary.<br>
+		/// Each time the shoe is populated or reshuffled, the next ordering is used, starting from "m_nextLibraryShoe".
+		/// </summary>
+		const ShoeLibrary* m_shoeLibrary;
+		long long m_nextLibraryShoe;
 	};
 
 	/// <summary>
@@ -53,6 +150,33 @@ namespace blackjack
 	/// <returns>A pointer to the created game in memory.</returns>
 	Game* InitGame(bool _debug);
 
+	/// <summary>
+	/// Allocate memory to and initialize a new game instance in the heap, with a choice of shoe size.
+	/// </summary>
+	/// <param name="_debug">Whether or not the game is being run in "Debug Mode", where the "Hole Card" is made face-up.</param>
+	/// <param name="_decks">The amount of full decks loaded into the shoe. MUST be from 1 to "c_maxShoeDecks".</param>
+	/// <param name="_backgroundShuffle">Whether reshuffles are prepared by a producer thread. Only worth it with spare cores.</param>
+	/// <returns>A pointer to the created game in memory.</returns>
+	Game* InitGame(bool _debug, int _decks, bool _backgroundShuffle);
+
+	/// <summary>
+	/// Put a game back into the state it was in when it was created, without allocating anything.<br>
+	/// The shoe is re-populated and shuffled, hands are emptied, and banks are reset to what they started at.<br>
+	/// The game isn't waiting for any input afterwards, until StartGame is called again.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	/// <param name="_seed">The new seed for the game's generator. The same seed will always produce the same shoe.</param>
+	void ResetGame(Game* _game, unsigned long long _seed);
+
+	/// <summary>
+	/// Deal from a library of recorded orderings instead of shuffling, starting from the next time the game is reset.<br>
+	/// The library's decks must match the game's shoe, and the shoe must not be continuous, as that draws each card at random.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	/// <param name="_library">The library to deal from, which must stay open while the game uses it. nullptr to go back to shuffling.</param>
+	/// <param name="_firstShoe">The index of the first ordering to deal. Every shoe after it uses the next ordering along.</param>
+	void SetShoeLibrary(Game* _game, const ShoeLibrary* _library, long long _firstShoe);
+
 	/// <summary>
 	/// Free the memory allocated to a game instance and its "children" stored in the heap, and nullify their pointers.
 	/// </summary>
@@ -60,22 +184,60 @@ namespace blackjack
 	void EndGame(Game*& _game);
 
 	/// <summary>
-	/// Main function that dictates the structure of the game.
+	/// Main function that dictates the structure of the game.<br>
+	/// Runs the game's states on the console, reading each input from std::cin until the game is finished.
 	/// </summary>
 	/// <param name="_game">The game instance.</param>
 	void GameLoop(Game* _game);
 
 	/// <summary>
-	/// The player may select how much of their remaining money they wish to bet.
+	/// Runs the game's states on the console, just like GameLoop, while recording every input given to the game.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	/// <param name="o_trace">The trace that every input is added onto. nullptr to not record anything.</param>
+	void GameLoop(Game* _game, InputTrace* o_trace);
+
+	/// <summary>
+	/// Start the first round of the game, leaving it waiting for the player's bet.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	void StartGame(Game* _game);
+
+	/// <summary>
+	/// Give the game the input it is waiting for, and run it until it needs another input (or is finished).<br>
+	/// Nothing here reads input itself, so whatever is driving the game can suspend it between inputs.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	/// <param name="_input">The input for the current state. MUST be from 1 to GetInputMax, or 0 for a pause state.</param>
+	void AdvanceGame(Game* _game, int _input);
+
+	/// <summary>
+	/// Get the largest input that the current state will accept.
 	/// </summary>
 	/// <param name="_game">The game instance.</param>
-	void SelectBet(Game* _game);
+	/// <returns>The amount of options, the player's bank for a bet, or 0 if the game is paused or finished.</returns>
+	int GetInputMax(const Game* _game);
 
 	/// <summary>
-	/// The player may select whether they want their aces to be valued at 1 or 11. This value is saved to the game struct.
+	/// Display the prompt for the input the game is currently waiting for, for anything driving the game without the console.<br>
+	/// Pause states can't wait for "any key" over a line of input, so they ask for enter instead.
 	/// </summary>
 	/// <param name="_game">The game instance.</param>
-	void SelectAceValue(Game* _game);
+	void DisplayGamePrompt(Game* _game);
+
+	/// <summary>
+	/// The player has selected how much of their remaining money they wish to bet.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	/// <param name="_bet">The chosen bet, from 1 to the player's bank.</param>
+	void SelectBet(Game* _game, int _bet);
+
+	/// <summary>
+	/// The player has selected whether they want their aces to be valued at 1 or 11. This value is saved to the game struct.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	/// <param name="_option">The chosen option. (1) for 1, (2) for 11.</param>
+	void SelectAceValue(Game* _game, int _option);
 
 	/// <summary>
 	/// The player and dealer are both dealt 2 cards. One of the dealer's cards is dealt face down.
@@ -84,10 +246,11 @@ namespace blackjack
 	void InitialDeal(Game* _game);
 
 	/// <summary>
-	/// At this point, the player may choose to hit or stand.
+	/// At this point, the player has chosen to hit or stand.
 	/// </summary>
 	/// <param name="_game">The game instance.</param>
-	void PlayerTurn(Game* _game);
+	/// <param name="_option">The chosen option. (1) to hit, (2) to stand.</param>
+	void PlayerTurn(Game* _game, int _option);
 
 	/// <summary>
 	/// The dealer flips their face down card over. They deal themselves cards until their hand is valued over 17.
@@ -108,17 +271,48 @@ namespace blackjack
 	void DiscardHands(Game* _game);
 
 	/// <summary>
-	/// Check if the player wants to continue playing the game.
+	/// Deal the initial hands and turn the dealer's first card face down, without displaying anything.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	void DealInitialHands(Game* _game);
+
+	/// <summary>
+	/// Turn the dealer's first card face up, then deal them cards until their hand is valued 17 or over, without displaying anything.
 	/// </summary>
-	/// <returns>True if the player wants to continue playing.</returns>
-	bool EndOfRound();
+	/// <param name="_game">The game instance.</param>
+	void PlayDealerHand(Game* _game);
+
+	/// <summary>
+	/// Get how much money is paid back to the player for a result, including their original bet.
+	/// </summary>
+	/// <param name="_result">The player's hand compared to the dealer's.</param>
+	/// <param name="_bet">The amount of money the player bet.</param>
+	/// <returns>The total amount paid back. 0 if the player lost.</returns>
+	int GetPayout(eHandValidityComparison _result, int _bet);
+
+	/// <summary>
+	/// Settle every side bet on the table from the initial deal, paying the player back for any that won.<br>
+	/// Each side bet's money is taken out of the bet pool, whether it won or not. MUST be called straight after DealInitialHands.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	/// <param name="o_results">The result of each side bet, indexed by eSideBet. Side bets without any money on them always give nothing.</param>
+	/// <returns>The total amount paid back to the player, including the side bets themselves.</returns>
+	int SettleSideBets(Game* _game, eSideBetResult o_results[TOTAL_SIDE_BETS]);
+
+	/// <summary>
+	/// The player has chosen whether they want to continue playing the game.
+	/// </summary>
+	/// <param name="_game">The game instance.</param>
+	/// <param name="_option">The chosen option. (1) to start another round, (2) to finish the game.</param>
+	void EndOfRound(Game* _game, int _option);
 
 	/// <summary>
-	/// Deal a card from the game's primary deck, into a player's hand.
+	/// Deal a card from the game's shoe, into a player's hand.<br>
+	/// If this empties the shoe, the discard pile is shuffled back into it.
 	/// </summary>
 	/// <param name="_game">The game instance.</param>
 	/// <param name="_hand">The player's hand to deal a card into.</param>
-	void DealCard(Game* _game, Deck* _hand);
+	void DealCard(Game* _game, Hand* _hand);
 
 	/// <summary>
 	/// Display information that is needed at multiple states of the game.<br>
@@ -1,22 +1,41 @@
 #include "Hand.h"
 
+#include <cassert>
 #include <iostream>
 
 namespace blackjack
 {
-	int GetTotalHandValue(Deck* _hand, const int _aceValue)
+	void AddCard(Hand* _hand, const Card* _card)
+	{
+		// A hand can't get this big without going bust first, so running out of room means a caller kept dealing to a bust hand.
+		// Dropping the card would leave the total unchanged, and a loop waiting for it to change would never end, so this is caught in debug builds.
+		assert(_hand->m_size < c_maxHandSize);
+		if (_hand->m_size < c_maxHandSize)
+		{
+			_hand->m_cards[_hand->m_size] = *_card;
+			_hand->m_size++;
+		}
+	}
+
+	void ClearHand(Hand* _hand)
+	{
+		// The cards don't need clearing, since anything past m_size is never read.
+		_hand->m_size = 0;
+	}
+
+	int GetTotalHandValue(Hand* _hand, const int _aceValue)
 	{
 		// Sum together the values of every card in the hand.
 		auto totalHandValue = 0;
 		for (auto cardIndex = 0; cardIndex < _hand->m_size; cardIndex++)
 		{
 			// Multiply the card's value by its visibility means that face-down cards don't contribute to the total value.
-			totalHandValue += GetCardValue(_hand->m_cards[cardIndex], _aceValue) * _hand->m_cards[cardIndex]->m_visible;
+			totalHandValue += GetCardValue(&_hand->m_cards[cardIndex], _aceValue) * _hand->m_cards[cardIndex].m_visible;
 		}
 		return totalHandValue;
 	}
 
-	eHandValidity IsHandValid(Deck* _hand, const int _aceValue)
+	eHandValidity IsHandValid(Hand* _hand, const int _aceValue)
 	{
 		const auto total_hand_value = GetTotalHandValue(_hand, _aceValue);
 
@@ -26,7 +45,7 @@ namespace blackjack
 		return (eHandValidity)((total_hand_value <= 21) + (_hand->m_size == 2 && total_hand_value == 21));
 	}
 
-	eHandValidityComparison CompareHands(Deck* _handA, Deck* _handB, const int _aceValue)
+	eHandValidityComparison CompareHands(Hand* _handA, Hand* _handB, const int _aceValue)
 	{
 		const auto handAValidity = IsHandValid(_handA, _aceValue);
 		const auto handBValidity = IsHandValid(_handB, _aceValue);
@@ -51,7 +70,7 @@ namespace blackjack
 		return (eHandValidityComparison)(tie + (!bust && !tie) * (win * 2 + natural));
 	}
 
-	void DisplayHand(Deck* _hand, const int _aceValue, char o_returnValue[][c_maxDisplayLength], const int _column, const int _offset)
+	void DisplayHand(Hand* _hand, const int _aceValue, char o_returnValue[][c_maxDisplayLength], const int _column, const int _offset)
 	{
 		char cardValue[3];
 		int returnLineIndex;
@@ -61,16 +80,16 @@ namespace blackjack
 			returnLineIndex = i * _column + + _offset;
 			
 			char cardName[c_maxCardNameSize];
-			GetCardName(_hand->m_cards[i], cardName);
+			GetCardName(&_hand->m_cards[i], cardName);
 
 			// String memory manipulation can be used directly on the return value, since it's a 2D array.
 			// The first dimension does degrade to a pointer, but the second dimension is what's being copied to.
 			strcpy_s(o_returnValue[returnLineIndex], "Card: ");
 			strcat_s(o_returnValue[returnLineIndex], cardName);
 
-			if (_hand->m_cards[i]->m_visible)
+			if (_hand->m_cards[i].m_visible)
 			{
-				GetValueString(GetCardValue(_hand->m_cards[i], _aceValue), cardValue);
+				GetValueString(GetCardValue(&_hand->m_cards[i], _aceValue), cardValue);
 
 				strcat_s(o_returnValue[returnLineIndex], " (");
 				strcat_s(o_returnValue[returnLineIndex], cardValue);
@@ -3,7 +3,7 @@
 #ifndef HAND_H_
 #define HAND_H_
 
-#include "Deck.h"
+#include "Card.h"
 
 namespace blackjack
 {
@@ -29,9 +29,22 @@ namespace blackjack
 	};
 
 	/// <summary>
-	/// 4 1-Aces, 4 Twos, and 3 Threes makes a perfect 21. Adding one for bust, a player cannot possibly have more cards in their hand than this.
+	/// Every card is worth at least 1, and no hand ever takes another card once it's bust, so a hand can hold at most 21 cards and then one more for bust.<br>
+	/// An 8 deck shoe has 32 Aces, so with Aces worth 1 this really can be dealt. It holds for any shoe size, since it doesn't depend on how many of each card there are.
 	/// </summary>
-	constexpr auto c_maxHandSize = 12;
+	constexpr auto c_maxHandSize = 22;
+
+	/// <summary>
+	/// The cards in a player's hand. Cards are copied in from the shoe when they're dealt, so reading a hand never leaves it.
+	/// </summary>
+	struct Hand
+	{
+		/// <summary>
+		/// The size comes before the cards, so that it's always next to the first cards in memory, however big the hand can get.
+		/// </summary>
+		int m_size;
+		Card m_cards[c_maxHandSize];
+	};
 
 	/// <summary>
 	/// The max amount of lines that can be displayed when printing card columns.<br>
@@ -45,13 +58,26 @@ namespace blackjack
 	/// </summary>
 	constexpr auto c_maxDisplayLength = c_maxCardNameSize + 12;
 
+	/// <summary>
+	/// Copy a card into a hand, incrementing its size value.
+	/// </summary>
+	/// <param name="_hand">The hand to add the card into.</param>
+	/// <param name="_card">The card to be added.</param>
+	void AddCard(Hand* _hand, const Card* _card);
+
+	/// <summary>
+	/// Empty a hand, so that it can be reused.
+	/// </summary>
+	/// <param name="_hand">The hand to be emptied.</param>
+	void ClearHand(Hand* _hand);
+
 	/// <summary>
 	/// Get the total combined value of a hand. If a card is face down, it is not counted.
 	/// </summary>
 	/// <param name="_hand">The hand to be accumulated.</param>
 	/// <param name="_aceValue">The integer value of Aces (should be 1 or 11, set elsewhere in the program)</param>
 	/// <returns>An integer value corresponding to the hand's total value.</returns>
-	int GetTotalHandValue(Deck* _hand, int _aceValue);
+	int GetTotalHandValue(Hand* _hand, int _aceValue);
 
 	/// <summary>
 	/// Perform a check on a hand to determine its validity.
@@ -59,7 +85,7 @@ namespace blackjack
 	/// <param name="_hand">The hand to be checked.</param>
 	/// <param name="_aceValue">The integer value of Aces (should be 1 or 11, set elsewhere in the program)</param>
 	/// <returns>An enum value determining whether the hand is bust, valid, or natural.</returns>
-	eHandValidity IsHandValid(Deck* _hand, int _aceValue);
+	eHandValidity IsHandValid(Hand* _hand, int _aceValue);
 
 	/// <summary>
 	/// Compare a hand to another and determine whether it wins against it.
@@ -68,7 +94,7 @@ namespace blackjack
 	/// <param name="_handB">The hand to check against.</param>
 	/// <param name="_aceValue">The integer value of Aces (should be 1 or 11, set elsewhere in the program)</param>
 	/// <returns>An enum value determining whether the hand loses, ties, wins, or holds a winning natural.</returns>
-	eHandValidityComparison CompareHands(Deck* _handA, Deck* _handB, int _aceValue);
+	eHandValidityComparison CompareHands(Hand* _handA, Hand* _handB, int _aceValue);
 
 	/// <summary>
 	/// Copy the data of a hand into a specifically formatted 2D char-array used to display columns.
@@ -78,7 +104,7 @@ namespace blackjack
 	/// <param name="o_returnValue">A 2D char array to be output into. MUST be at least the dimensions ("c_maxDisplaySize * TOTAL_PLAYERS", "c_maxDisplayLength")</param>
 	/// <param name="_column">The column this data will be output in. MUST be less than the enum value "TOTAL_PLAYERS"</param>
 	/// <param name="_offset">The offset of this data in the 2D array, in-case there is additional data above it in the column.</param>
-	void DisplayHand(Deck* _hand, int _aceValue, char o_returnValue[][c_maxDisplayLength], int _column, int _offset);
+	void DisplayHand(Hand* _hand, int _aceValue, char o_returnValue[][c_maxDisplayLength], int _column, int _offset);
 }
 
 #endif
@@ -11,8 +11,7 @@ namespace blackjack
 
 		while (playerInput == 0)
 		{
-			std::cout << "Please select " << _inputName << " from " << _valuePrefix << "1" << _valueSuffix << " to " <<
-				_valuePrefix << _maxValue << _valueSuffix << ": " << _inputPrefix;
+			DisplayInputPrompt(std::cout, _maxValue, _inputName, _valuePrefix, _valueSuffix, _inputPrefix);
 
 			// If the value that is read by std::cin is invalid, i.e. a user entering "a", it will return false.
 			// This can just be mixed with an OR of the range validation.
@@ -38,6 +37,34 @@ namespace blackjack
 		return GetInput(_maxValue, "a value", "\x9C", "", "\x9C");
 	}
 
+	void DisplayInputPrompt(std::ostream& _output, const int _maxValue, const char _inputName[],
+		const char _valuePrefix[], const char _valueSuffix[], const char _inputPrefix[])
+	{
+		_output << "Please select " << _inputName << " from " << _valuePrefix << "1" << _valueSuffix << " to " <<
+			_valuePrefix << _maxValue << _valueSuffix << ": " << _inputPrefix;
+	}
+
+	bool ParseLine(const char _line[], int& o_returnValue)
+	{
+		for (auto i = 0; i < c_maxInputLength; i++)
+		{
+			// Reaching the end of the line means every character before it was a number value.
+			if (_line[i] == 0)
+			{
+				o_returnValue = atoi(_line);
+				return true;
+			}
+
+			if (_line[i] < '0' || _line[i] > '9')
+			{
+				return false;
+			}
+		}
+
+		// The line was longer than c_maxInputLength.
+		return false;
+	}
+
 	bool ReadLine(int& o_returnValue)
 	{
 		char intArray[c_maxInputLength];
@@ -3,6 +3,8 @@
 #ifndef INPUT_H_
 #define INPUT_H_
 
+#include <iosfwd>
+
 namespace blackjack
 {
 	constexpr auto c_maxInputLength = 16;
@@ -32,6 +34,26 @@ namespace blackjack
 	/// <returns>The chosen bet.</returns>
 	int GetBet(int _maxValue);
 
+	/// <summary>
+	/// Display the prompt that GetInput shows before reading the user's input, to any output stream.
+	/// </summary>
+	/// <param name="_output">The stream to display the prompt to.</param>
+	/// <param name="_maxValue">The amount of options, maximum value that can be entered, etc.</param>
+	/// <param name="_inputName">What the input will be described as i.e. "an option".</param>
+	/// <param name="_valuePrefix">A prefix to be displayed before the min / max values.</param>
+	/// <param name="_valueSuffix">A suffix to be displayed after the min / max values.</param>
+	/// <param name="_inputPrefix">A prefix to be displayed before the user's input.</param>
+	void DisplayInputPrompt(std::ostream& _output, int _maxValue, const char _inputName[], const char _valuePrefix[], const char _valueSuffix[], const char _inputPrefix[]);
+
+	/// <summary>
+	/// Validate a line of input that has already been read, the same way that ReadLine does.<br>
+	/// Lines of "c_maxInputLength" characters or more are invalid, as are lines with anything other than digits in them.
+	/// </summary>
+	/// <param name="_line">The null-terminated line, without its newline.</param>
+	/// <param name="o_returnValue">Integer to store input in, if the line is valid.</param>
+	/// <returns>Returns true if the line is a valid integer.</returns>
+	bool ParseLine(const char _line[], int& o_returnValue);
+
 	/// <summary>
 	/// Read whatever the user has put into the input stream and validate whether or not is an integer value.<br>
 	/// Will only read up to "c_maxInputLength" characters.
@@ -0,0 +1,689 @@
+#include "Lockstep.h"
+
+#include <cmath>
+#include <cstring>
+#include <immintrin.h>
+
+#include "BatchRandom.h"
+#include "Random.h"
+#include "Solver.h"
+#include "Strategy.h"
+#include "Tracepoints.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// Every rank fits in one lookup register, since there are fewer than 16 of them.
+	/// </summary>
+	constexpr auto c_lockstepLookupSize = 16;
+
+	/// <summary>
+	/// Everything about a simulation's rules that's the same on every table.<br>
+	/// Card values are looked up by rank, so that a whole register of cards can be valued at once.
+	/// </summary>
+	struct LockstepRules
+	{
+		int m_values[c_lockstepLookupSize];
+		int m_hiLoValues[c_lockstepLookupSize];
+		int m_valueClasses[c_lockstepLookupSize];
+
+		/// <summary>
+		/// The strategy the player follows, or nullptr if they hit until the stand threshold.
+		/// </summary>
+		const StrategyTable* m_strategy;
+		int m_standThreshold;
+
+		int m_shoeSize;
+	};
+
+	/// <summary>
+	/// Every table a lockstep worker plays, stored as one array per field so that a register can be loaded from each.<br>
+	/// Each shoe is treated exactly like a Shoe, as a ring split into the discard pile, the cards in play, and the undealt cards.
+	/// Only ranks are kept, since suits never change how a round plays out.
+	/// </summary>
+	struct LockstepTables
+	{
+		unsigned char m_ranks[c_lockstepTables][c_lockstepShoeStride];
+
+		/// <summary>
+		/// The position of each table's next card to deal. Dealing only ever moves this along one, and reshuffling never moves it at all.
+		/// </summary>
+		int m_nextCards[c_lockstepTables];
+		int m_discardBegins[c_lockstepTables];
+		int m_discardSizes[c_lockstepTables];
+		int m_inPlaySizes[c_lockstepTables];
+		int m_runningCounts[c_lockstepTables];
+
+		/// <summary>
+		/// Each table's result for the round that was just played, as an eHandValidityComparison.
+		/// </summary>
+		int m_results[c_lockstepTables];
+
+		/// <summary>
+		/// -1 for every table that is playing a session, and 0 for every table that has run out of sessions. Loaded directly as a mask.
+		/// </summary>
+		int m_active[c_lockstepTables];
+
+		int m_banks[c_lockstepTables];
+		int m_bets[c_lockstepTables];
+		int m_rounds[c_lockstepTables];
+		int m_peakBanks[c_lockstepTables];
+		int m_maxDrawdowns[c_lockstepTables];
+		BetState m_betStates[c_lockstepTables];
+		BatchRandom m_shuffleRandoms[c_lockstepTables];
+	};
+
+	/// <summary>
+	/// Wrap a position past the end of a table's shoe back around to the start, the same way as a Shoe.
+	/// </summary>
+	static int WrapTablePosition(const LockstepRules* _rules, const int _position)
+	{
+		return _position < _rules->m_shoeSize ? _position : _position - _rules->m_shoeSize;
+	}
+
+	/// <summary>
+	/// Shuffle a table's discard pile in place and make it the undealt cards, exactly like ReshuffleDiscard.
+	/// </summary>
+	static void ReshuffleTable(LockstepTables* _tables, const LockstepRules* _rules, const int _table)
+	{
+		auto* ranks = _tables->m_ranks[_table];
+		const auto begin = _tables->m_discardBegins[_table];
+		const auto size = _tables->m_discardSizes[_table];
+
+		unsigned short swaps[c_maxShoeSize];
+		GenerateShuffleSwaps(&_tables->m_shuffleRandoms[_table], swaps, size);
+		for (auto cardIndex = size - 1; cardIndex > 0; cardIndex--)
+		{
+			const auto a = WrapTablePosition(_rules, begin + cardIndex);
+			const auto b = WrapTablePosition(_rules, begin + swaps[cardIndex]);
+
+			const auto temp = ranks[a];
+			ranks[a] = ranks[b];
+			ranks[b] = temp;
+		}
+
+		_tables->m_discardBegins[_table] = WrapTablePosition(_rules, begin + size);
+		_tables->m_discardSizes[_table] = 0;
+
+		_tables->m_runningCounts[_table] = 0;
+		for (auto cardIndex = 0; cardIndex < _tables->m_inPlaySizes[_table]; cardIndex++)
+		{
+			_tables->m_runningCounts[_table] += _rules->m_hiLoValues[ranks[WrapTablePosition(_rules, _tables->m_discardBegins[_table] + cardIndex)]];
+		}
+	}
+
+	/// <summary>
+	/// Put a table into the state ResetGame would put a game in for a session, populating and shuffling its shoe from the session's seed.
+	/// </summary>
+	static void StartTableSession(LockstepTables* _tables, const LockstepRules* _rules, const SimulationSettings* _settings, const int _table,
+		const long long _session)
+	{
+		Random random;
+		SeedRandom(&random, DeriveSeed(_settings->m_seed, (unsigned long long)_session));
+		SeedBatchRandom(&_tables->m_shuffleRandoms[_table], NextRandom(&random));
+
+		auto* ranks = _tables->m_ranks[_table];
+		for (auto cardIndex = 0; cardIndex < _rules->m_shoeSize; cardIndex++)
+		{
+			ranks[cardIndex] = (unsigned char)(cardIndex % c_maxDeckSize % TOTAL_RANKS);
+		}
+
+		// Nothing has been dealt yet, so the undealt cards are the whole shoe, in order from the start.
+		unsigned short swaps[c_maxShoeSize];
+		GenerateShuffleSwaps(&_tables->m_shuffleRandoms[_table], swaps, _rules->m_shoeSize);
+		for (auto cardIndex = _rules->m_shoeSize - 1; cardIndex > 0; cardIndex--)
+		{
+			const auto temp = ranks[cardIndex];
+			ranks[cardIndex] = ranks[swaps[cardIndex]];
+			ranks[swaps[cardIndex]] = temp;
+		}
+
+		_tables->m_nextCards[_table] = 0;
+		_tables->m_discardBegins[_table] = 0;
+		_tables->m_discardSizes[_table] = 0;
+		_tables->m_inPlaySizes[_table] = 0;
+		_tables->m_runningCounts[_table] = 0;
+
+		_tables->m_banks[_table] = _settings->m_startingBank;
+		_tables->m_rounds[_table] = 0;
+		_tables->m_peakBanks[_table] = _settings->m_startingBank;
+		_tables->m_maxDrawdowns[_table] = 0;
+		_tables->m_betStates[_table] = BetState{ 0 };
+	}
+
+	/// <summary>
+	/// Check whether a session carries on for another round, using the same rules as RunRiskOfRuin's scalar engine.
+	/// </summary>
+	static bool IsSessionContinuing(const SimulationSettings* _settings, const int _bank, const int _rounds)
+	{
+		return _rounds < _settings->m_maxRounds && _bank >= 1 && _bank > _settings->m_stopLoss && (_settings->m_stopWin == 0 || _bank < _settings->m_stopWin);
+	}
+
+	/// <summary>
+	/// Start the next session that needs to be played on a table, claiming another batch of sessions if needed.<br>
+	/// Sessions that end before their first round are added to the report straight away.
+	/// </summary>
+	/// <returns>True if the table is playing a session. False if there are no sessions left.</returns>
+	static bool StartNextSession(LockstepTables* _tables, const LockstepRules* _rules, const SimulationSettings* _settings, const int _table,
+		std::atomic<long long>* _nextSession, long long& _batchBegin, long long& _batchEnd, RuinReport* o_report)
+	{
+		const auto sessionEnd = _settings->m_firstSession + _settings->m_sessions;
+		for (;;)
+		{
+			if (_batchBegin >= _batchEnd)
+			{
+				_batchBegin = _nextSession->fetch_add(c_sessionBatchSize);
+				_batchEnd = _batchBegin + c_sessionBatchSize < sessionEnd ? _batchBegin + c_sessionBatchSize : sessionEnd;
+				if (_batchBegin >= sessionEnd)
+				{
+					_tables->m_active[_table] = 0;
+					return false;
+				}
+			}
+
+			StartTableSession(_tables, _rules, _settings, _table, _batchBegin++);
+			if (IsSessionContinuing(_settings, _tables->m_banks[_table], 0))
+			{
+				_tables->m_active[_table] = -1;
+				return true;
+			}
+
+			AddSessionToReport(o_report, 0, _tables->m_banks[_table], 0);
+		}
+	}
+
+	/// <summary>
+	/// Look up a value for every lane's rank, from a table of one value per rank.
+	/// </summary>
+	static __m256i LookupAVX2(const int _lookup[c_lockstepLookupSize], const __m256i _ranks)
+	{
+		// Each permute only reads the lowest three bits, so the two halves of the table are looked up separately.
+		const auto low = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*)&_lookup[0]), _ranks);
+		const auto high = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*)&_lookup[8]), _ranks);
+		return _mm256_blendv_epi8(low, high, _mm256_cmpgt_epi32(_ranks, _mm256_set1_epi32(7)));
+	}
+
+	/// <summary>
+	/// Deal one card on every masked table, out of eight starting from the first, exactly like DealCard with a Shoe.<br>
+	/// Any table that runs out of cards has its discard pile reshuffled straight away.
+	/// </summary>
+	/// <returns>The rank of every dealt card, and 0 for tables that weren't dealt to.</returns>
+	static __m256i DealAVX2(LockstepTables* _tables, const LockstepRules* _rules, const int _first, const __m256i _mask)
+	{
+		const auto shoeSize = _mm256_set1_epi32(_rules->m_shoeSize);
+
+		const auto positions = _mm256_loadu_si256((const __m256i*)&_tables->m_nextCards[_first]);
+		const auto tables = _mm256_add_epi32(_mm256_set1_epi32(_first), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+		const auto offsets = _mm256_add_epi32(_mm256_mullo_epi32(tables, _mm256_set1_epi32(c_lockstepShoeStride)), positions);
+
+		// Gathers read four bytes, so the rank is the lowest of them. The shoe's stride leaves room to read past its last card.
+		const auto ranks = _mm256_and_si256(_mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int*)&_tables->m_ranks[0][0], offsets, _mask, 1),
+			_mm256_set1_epi32(0xFF));
+
+		// The mask is -1 for every dealt table, so subtracting it moves them along one.
+		auto nextCards = _mm256_sub_epi32(positions, _mask);
+		nextCards = _mm256_andnot_si256(_mm256_cmpeq_epi32(nextCards, shoeSize), nextCards);
+		_mm256_storeu_si256((__m256i*)&_tables->m_nextCards[_first], nextCards);
+
+		const auto inPlaySizes = _mm256_sub_epi32(_mm256_loadu_si256((const __m256i*)&_tables->m_inPlaySizes[_first]), _mask);
+		_mm256_storeu_si256((__m256i*)&_tables->m_inPlaySizes[_first], inPlaySizes);
+
+		const auto runningCounts = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)&_tables->m_runningCounts[_first]),
+			_mm256_and_si256(LookupAVX2(_rules->m_hiLoValues, ranks), _mask));
+		_mm256_storeu_si256((__m256i*)&_tables->m_runningCounts[_first], runningCounts);
+
+		// A table is out of cards once its discard pile and the cards in play make up the whole shoe. This hardly ever happens.
+		const auto discardSizes = _mm256_loadu_si256((const __m256i*)&_tables->m_discardSizes[_first]);
+		const auto empty = _mm256_and_si256(_mm256_cmpeq_epi32(_mm256_add_epi32(discardSizes, inPlaySizes), shoeSize), _mask);
+		const auto emptyTables = _mm256_movemask_ps(_mm256_castsi256_ps(empty));
+		if (emptyTables != 0)
+		{
+			for (auto lane = 0; lane < c_lockstepTablesAVX2; lane++)
+			{
+				if ((emptyTables >> lane & 1) != 0)
+				{
+					ReshuffleTable(_tables, _rules, _first + lane);
+				}
+			}
+		}
+
+		return ranks;
+	}
+
+	/// <summary>
+	/// Find which of eight tables' players want to hit, given their hand totals and the dealer's face-up card.
+	/// </summary>
+	static __m256i GetPlayerHitsAVX2(const LockstepRules* _rules, const __m256i _mask, const __m256i _totals, const __m256i _upcardClasses)
+	{
+		if (_rules->m_strategy == nullptr)
+		{
+			return _mm256_and_si256(_mask, _mm256_cmpgt_epi32(_mm256_set1_epi32(_rules->m_standThreshold), _totals));
+		}
+
+		// Basic strategy only covers hands that aren't bust, so bust hands are masked out of the gather entirely.
+		const auto valid = _mm256_and_si256(_mask, _mm256_cmpgt_epi32(_mm256_set1_epi32(c_solvedTotals), _totals));
+		const auto indices = _mm256_add_epi32(_mm256_mullo_epi32(_totals, _mm256_set1_epi32(c_valueClasses)), _upcardClasses);
+		const auto actions = _mm256_mask_i32gather_epi32(_mm256_set1_epi32(PLAYER_ACTION_STAND), (const int*)&_rules->m_strategy->m_actions[0][0],
+			indices, valid, 4);
+
+		return _mm256_and_si256(valid, _mm256_cmpeq_epi32(actions, _mm256_set1_epi32(PLAYER_ACTION_HIT)));
+	}
+
+	/// <summary>
+	/// Play one round on eight tables, from the first, with every table's bet already taken from its bank.
+	/// </summary>
+	static void PlayRoundAVX2(LockstepTables* _tables, const LockstepRules* _rules, const int _first)
+	{
+		const auto active = _mm256_loadu_si256((const __m256i*)&_tables->m_active[_first]);
+		const auto one = _mm256_set1_epi32(1);
+		const auto two = _mm256_set1_epi32(2);
+		const auto twentyOne = _mm256_set1_epi32(21);
+
+		// The same order as DealInitialHands: dealer, player, dealer, player. The dealer's second card is the face-up one.
+		auto dealerTotals = _mm256_and_si256(LookupAVX2(_rules->m_values, DealAVX2(_tables, _rules, _first, active)), active);
+		auto playerTotals = _mm256_and_si256(LookupAVX2(_rules->m_values, DealAVX2(_tables, _rules, _first, active)), active);
+
+		const auto upcards = DealAVX2(_tables, _rules, _first, active);
+		dealerTotals = _mm256_add_epi32(dealerTotals, _mm256_and_si256(LookupAVX2(_rules->m_values, upcards), active));
+		const auto upcardClasses = LookupAVX2(_rules->m_valueClasses, upcards);
+
+		playerTotals = _mm256_add_epi32(playerTotals, _mm256_and_si256(LookupAVX2(_rules->m_values, DealAVX2(_tables, _rules, _first, active)), active));
+
+		auto playerSizes = _mm256_and_si256(active, two);
+		auto dealerSizes = playerSizes;
+
+		// Each table only carries on hitting while it has hit every time so far, just like the scalar loop stopping at its first stand.
+		auto hitting = GetPlayerHitsAVX2(_rules, active, playerTotals, upcardClasses);
+		while (!_mm256_testz_si256(hitting, hitting))
+		{
+			playerTotals = _mm256_add_epi32(playerTotals, _mm256_and_si256(LookupAVX2(_rules->m_values, DealAVX2(_tables, _rules, _first, hitting)), hitting));
+			playerSizes = _mm256_sub_epi32(playerSizes, hitting);
+			hitting = GetPlayerHitsAVX2(_rules, hitting, playerTotals, upcardClasses);
+		}
+
+		// The dealer plays out every hand, even if the player is bust, so the same cards are dealt as in PlayDealerHand.
+		const auto dealerStandValue = _mm256_set1_epi32(c_dealerStandValue);
+		hitting = _mm256_and_si256(active, _mm256_cmpgt_epi32(dealerStandValue, dealerTotals));
+		while (!_mm256_testz_si256(hitting, hitting))
+		{
+			dealerTotals = _mm256_add_epi32(dealerTotals, _mm256_and_si256(LookupAVX2(_rules->m_values, DealAVX2(_tables, _rules, _first, hitting)), hitting));
+			dealerSizes = _mm256_sub_epi32(dealerSizes, hitting);
+			hitting = _mm256_and_si256(hitting, _mm256_cmpgt_epi32(dealerStandValue, dealerTotals));
+		}
+
+		// The same as CompareHands, with every condition as a mask. A hand's validity is 0 if bust, 1 if valid, and 2 if a natural.
+		const auto playerBust = _mm256_cmpgt_epi32(playerTotals, twentyOne);
+		const auto dealerBust = _mm256_cmpgt_epi32(dealerTotals, twentyOne);
+		const auto playerNatural = _mm256_and_si256(_mm256_cmpeq_epi32(playerSizes, two), _mm256_cmpeq_epi32(playerTotals, twentyOne));
+		const auto dealerNatural = _mm256_and_si256(_mm256_cmpeq_epi32(dealerSizes, two), _mm256_cmpeq_epi32(dealerTotals, twentyOne));
+		const auto playerValidity = _mm256_sub_epi32(_mm256_andnot_si256(playerBust, one), playerNatural);
+		const auto dealerValidity = _mm256_sub_epi32(_mm256_andnot_si256(dealerBust, one), dealerNatural);
+
+		const auto tie = _mm256_and_si256(_mm256_cmpeq_epi32(playerValidity, dealerValidity),
+			_mm256_or_si256(playerBust, _mm256_cmpeq_epi32(playerTotals, dealerTotals)));
+		const auto win = _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi32(playerTotals, dealerTotals), dealerBust),
+			_mm256_andnot_si256(dealerNatural, playerNatural));
+
+		const auto decided = _mm256_add_epi32(_mm256_and_si256(win, two), _mm256_and_si256(playerNatural, one));
+		const auto results = _mm256_add_epi32(_mm256_and_si256(tie, one), _mm256_andnot_si256(_mm256_or_si256(playerBust, tie), decided));
+		_mm256_storeu_si256((__m256i*)&_tables->m_results[_first], results);
+	}
+
+	/// <summary>
+	/// Deal one card on every masked table, exactly like DealCard with a Shoe.<br>
+	/// Any table that runs out of cards has its discard pile reshuffled straight away.
+	/// </summary>
+	/// <returns>The rank of every dealt card, and 0 for tables that weren't dealt to.</returns>
+	static __m512i DealAVX512(LockstepTables* _tables, const LockstepRules* _rules, const __mmask16 _mask)
+	{
+		const auto one = _mm512_set1_epi32(1);
+		const auto shoeSize = _mm512_set1_epi32(_rules->m_shoeSize);
+
+		const auto positions = _mm512_loadu_si512(_tables->m_nextCards);
+		const auto tables = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+		const auto offsets = _mm512_add_epi32(_mm512_mullo_epi32(tables, _mm512_set1_epi32(c_lockstepShoeStride)), positions);
+
+		const auto ranks = _mm512_and_si512(_mm512_mask_i32gather_epi32(_mm512_setzero_si512(), _mask, offsets, &_tables->m_ranks[0][0], 1),
+			_mm512_set1_epi32(0xFF));
+
+		auto nextCards = _mm512_mask_add_epi32(positions, _mask, positions, one);
+		nextCards = _mm512_mask_mov_epi32(nextCards, _mm512_cmpeq_epi32_mask(nextCards, shoeSize), _mm512_setzero_si512());
+		_mm512_storeu_si512(_tables->m_nextCards, nextCards);
+
+		auto inPlaySizes = _mm512_loadu_si512(_tables->m_inPlaySizes);
+		inPlaySizes = _mm512_mask_add_epi32(inPlaySizes, _mask, inPlaySizes, one);
+		_mm512_storeu_si512(_tables->m_inPlaySizes, inPlaySizes);
+
+		auto runningCounts = _mm512_loadu_si512(_tables->m_runningCounts);
+		runningCounts = _mm512_mask_add_epi32(runningCounts, _mask, runningCounts, _mm512_permutexvar_epi32(ranks, _mm512_loadu_si512(_rules->m_hiLoValues)));
+		_mm512_storeu_si512(_tables->m_runningCounts, runningCounts);
+
+		const auto discardSizes = _mm512_loadu_si512(_tables->m_discardSizes);
+		const auto emptyTables = _mm512_mask_cmpeq_epi32_mask(_mask, _mm512_add_epi32(discardSizes, inPlaySizes), shoeSize);
+		if (emptyTables != 0)
+		{
+			for (auto table = 0; table < c_lockstepTables; table++)
+			{
+				if ((emptyTables >> table & 1) != 0)
+				{
+					ReshuffleTable(_tables, _rules, table);
+				}
+			}
+		}
+
+		return ranks;
+	}
+
+	/// <summary>
+	/// Find which tables' players want to hit, given their hand totals and the dealer's face-up card.
+	/// </summary>
+	static __mmask16 GetPlayerHitsAVX512(const LockstepRules* _rules, const __mmask16 _mask, const __m512i _totals, const __m512i _upcardClasses)
+	{
+		if (_rules->m_strategy == nullptr)
+		{
+			return _mm512_mask_cmplt_epi32_mask(_mask, _totals, _mm512_set1_epi32(_rules->m_standThreshold));
+		}
+
+		const auto valid = _mm512_mask_cmplt_epi32_mask(_mask, _totals, _mm512_set1_epi32(c_solvedTotals));
+		const auto indices = _mm512_add_epi32(_mm512_mullo_epi32(_totals, _mm512_set1_epi32(c_valueClasses)), _upcardClasses);
+		const auto actions = _mm512_mask_i32gather_epi32(_mm512_set1_epi32(PLAYER_ACTION_STAND), valid, indices, &_rules->m_strategy->m_actions[0][0], 4);
+
+		return _mm512_mask_cmpeq_epi32_mask(valid, actions, _mm512_set1_epi32(PLAYER_ACTION_HIT));
+	}
+
+	/// <summary>
+	/// Play one round on every table, with every table's bet already taken from its bank.
+	/// </summary>
+	static void PlayRoundAVX512(LockstepTables* _tables, const LockstepRules* _rules)
+	{
+		const auto active = _mm512_cmpneq_epi32_mask(_mm512_loadu_si512(_tables->m_active), _mm512_setzero_si512());
+		const auto values = _mm512_loadu_si512(_rules->m_values);
+		const auto one = _mm512_set1_epi32(1);
+		const auto two = _mm512_set1_epi32(2);
+		const auto twentyOne = _mm512_set1_epi32(21);
+
+		auto dealerTotals = _mm512_maskz_permutexvar_epi32(active, DealAVX512(_tables, _rules, active), values);
+		auto playerTotals = _mm512_maskz_permutexvar_epi32(active, DealAVX512(_tables, _rules, active), values);
+
+		const auto upcards = DealAVX512(_tables, _rules, active);
+		dealerTotals = _mm512_add_epi32(dealerTotals, _mm512_maskz_permutexvar_epi32(active, upcards, values));
+		const auto upcardClasses = _mm512_permutexvar_epi32(upcards, _mm512_loadu_si512(_rules->m_valueClasses));
+
+		playerTotals = _mm512_add_epi32(playerTotals, _mm512_maskz_permutexvar_epi32(active, DealAVX512(_tables, _rules, active), values));
+
+		auto playerSizes = _mm512_maskz_mov_epi32(active, two);
+		auto dealerSizes = playerSizes;
+
+		auto hitting = GetPlayerHitsAVX512(_rules, active, playerTotals, upcardClasses);
+		while (hitting != 0)
+		{
+			playerTotals = _mm512_mask_add_epi32(playerTotals, hitting, playerTotals, _mm512_permutexvar_epi32(DealAVX512(_tables, _rules, hitting), values));
+			playerSizes = _mm512_mask_add_epi32(playerSizes, hitting, playerSizes, one);
+			hitting = GetPlayerHitsAVX512(_rules, hitting, playerTotals, upcardClasses);
+		}
+
+		const auto dealerStandValue = _mm512_set1_epi32(c_dealerStandValue);
+		hitting = _mm512_mask_cmplt_epi32_mask(active, dealerTotals, dealerStandValue);
+		while (hitting != 0)
+		{
+			dealerTotals = _mm512_mask_add_epi32(dealerTotals, hitting, dealerTotals, _mm512_permutexvar_epi32(DealAVX512(_tables, _rules, hitting), values));
+			dealerSizes = _mm512_mask_add_epi32(dealerSizes, hitting, dealerSizes, one);
+			hitting = _mm512_mask_cmplt_epi32_mask(hitting, dealerTotals, dealerStandValue);
+		}
+
+		// Naturals are never bust, so two hands have the same validity if they're both bust or not, and both naturals or not.
+		const auto playerBust = _mm512_cmpgt_epi32_mask(playerTotals, twentyOne);
+		const auto dealerBust = _mm512_cmpgt_epi32_mask(dealerTotals, twentyOne);
+		const auto playerNatural = (__mmask16)(_mm512_cmpeq_epi32_mask(playerSizes, two) & _mm512_cmpeq_epi32_mask(playerTotals, twentyOne));
+		const auto dealerNatural = (__mmask16)(_mm512_cmpeq_epi32_mask(dealerSizes, two) & _mm512_cmpeq_epi32_mask(dealerTotals, twentyOne));
+		const auto sameValidity = (__mmask16)(~(playerBust ^ dealerBust) & ~(playerNatural ^ dealerNatural));
+
+		const auto tie = (__mmask16)(sameValidity & (playerBust | _mm512_cmpeq_epi32_mask(playerTotals, dealerTotals)));
+		const auto win = (__mmask16)(_mm512_cmpgt_epi32_mask(playerTotals, dealerTotals) | dealerBust | (playerNatural & ~dealerNatural));
+		const auto decided = (__mmask16)~(playerBust | tie);
+
+		auto results = _mm512_maskz_mov_epi32((__mmask16)(win & decided), two);
+		results = _mm512_mask_add_epi32(results, (__mmask16)(playerNatural & decided), results, one);
+		results = _mm512_mask_mov_epi32(results, tie, one);
+		_mm512_storeu_si512(_tables->m_results, results);
+	}
+
+	/// <summary>
+	/// Play every session that can be claimed, "c_lockstepTables" at a time, with a chosen instruction set.
+	/// </summary>
+	static void PlayLockstepSessions(const SimulationSettings* _settings, std::atomic<long long>* _nextSession, RuinReport* o_report,
+		const eInstructionSet _instructionSet)
+	{
+		LockstepRules rules{};
+		for (auto rank = 0; rank < TOTAL_RANKS; rank++)
+		{
+			rules.m_values[rank] = GetRankValue((eRank)rank, _settings->m_aceValue);
+			rules.m_hiLoValues[rank] = c_hiLoValues[rank];
+			rules.m_valueClasses[rank] = GetValueClass((eRank)rank);
+		}
+		rules.m_strategy = _settings->m_basicStrategy ? GetBasicStrategy(_settings->m_aceValue) : nullptr;
+		rules.m_standThreshold = _settings->m_standThreshold;
+		rules.m_shoeSize = _settings->m_decks * c_maxDeckSize;
+
+		// The tables are far too big to be kept on the stack.
+		auto* tables = new LockstepTables{};
+		long long batchBegin = 0;
+		long long batchEnd = 0;
+
+		auto activeTables = 0;
+		for (auto table = 0; table < c_lockstepTables; table++)
+		{
+			activeTables += StartNextSession(tables, &rules, _settings, table, _nextSession, batchBegin, batchEnd, o_report);
+		}
+
+		while (activeTables > 0)
+		{
+			// Bets depend on each table's own bank, count, and history, so they're chosen one table at a time.
+			for (auto table = 0; table < c_lockstepTables; table++)
+			{
+				if (tables->m_active[table] == 0)
+				{
+					continue;
+				}
+
+				const auto undealtSize = rules.m_shoeSize - tables->m_discardSizes[table] - tables->m_inPlaySizes[table];
+				const auto trueCount = undealtSize > 0 ? tables->m_runningCounts[table] * c_maxDeckSize / undealtSize : 0;
+
+				tables->m_bets[table] = SelectPolicyBet(&_settings->m_betPolicy, &tables->m_betStates[table], tables->m_banks[table], trueCount);
+				tables->m_banks[table] -= tables->m_bets[table];
+			}
+
+			if (_instructionSet == INSTRUCTION_SET_AVX512)
+			{
+				PlayRoundAVX512(tables, &rules);
+			}
+			else
+			{
+				for (auto first = 0; first < c_lockstepTables; first += c_lockstepTablesAVX2)
+				{
+					PlayRoundAVX2(tables, &rules, first);
+				}
+			}
+
+			// Settling is also one table at a time, since a table whose session ends starts its next one straight away.
+			for (auto table = 0; table < c_lockstepTables; table++)
+			{
+				if (tables->m_active[table] == 0)
+				{
+					continue;
+				}
+
+				const auto result = (eHandValidityComparison)tables->m_results[table];
+				const auto bet = tables->m_bets[table];
+				const auto bankBefore = tables->m_banks[table] + bet;
+
+				tables->m_banks[table] += GetPayout(result, bet);
+				UpdateBetState(&tables->m_betStates[table], result);
+
+				const auto roundResult = (double)(tables->m_banks[table] - bankBefore) / bet;
+				o_report->m_totalResult += roundResult;
+				o_report->m_totalResultSquared += roundResult * roundResult;
+				tables->m_rounds[table]++;
+
+				const auto bank = tables->m_banks[table];
+				tables->m_peakBanks[table] = bank > tables->m_peakBanks[table] ? bank : tables->m_peakBanks[table];
+				const auto drawdown = tables->m_peakBanks[table] - bank;
+				tables->m_maxDrawdowns[table] = drawdown > tables->m_maxDrawdowns[table] ? drawdown : tables->m_maxDrawdowns[table];
+
+				// Every card in play is discarded at once, just like DiscardInPlay.
+				tables->m_discardSizes[table] += tables->m_inPlaySizes[table];
+				tables->m_inPlaySizes[table] = 0;
+
+				if (!IsSessionContinuing(_settings, tables->m_banks[table], tables->m_rounds[table]))
+				{
+					AddSessionToReport(o_report, tables->m_rounds[table], tables->m_banks[table], tables->m_maxDrawdowns[table]);
+					activeTables -= !StartNextSession(tables, &rules, _settings, table, _nextSession, batchBegin, batchEnd, o_report);
+				}
+			}
+		}
+
+		delete tables;
+	}
+
+	const char* GetLockstepUnsupportedReason(const SimulationSettings* _settings)
+	{
+		// The lockstep engine never goes through Game, so there'd be nothing for the tracker to attribute allocations to.
+		// For the same reason, it has no tracepoints, so while any ETW session is tracing, simulations are played through Game instead.
+		if (c_trackAllocations)
+		{
+			return "allocation tracking is built in";
+		}
+		if (g_enabledTracepoints != 0)
+		{
+			return "an ETW session is tracing";
+		}
+
+		// Tables only keep each card's rank, so side bets, which need suits, can't be settled in lockstep.
+		for (auto sideBet = 0; sideBet < TOTAL_SIDE_BETS; sideBet++)
+		{
+			if (_settings->m_sideBets[sideBet] > 0)
+			{
+				return "side bets are played";
+			}
+		}
+
+		if (_settings->m_continuousShuffle)
+		{
+			return "the shoe is continuously shuffled";
+		}
+		if (_settings->m_collectOutcomes)
+		{
+			return "outcomes are collected";
+		}
+		if (_settings->m_exportFormat != EXPORT_FORMAT_NONE)
+		{
+			return "rounds are exported";
+		}
+
+		// Recorded shoes are dealt through Game, while every table in lockstep shuffles its own.
+		if (_settings->m_shoeLibraryPath[0] != '\0')
+		{
+			return "recorded shoes are dealt";
+		}
+		if (GetSupportedInstructionSet() == INSTRUCTION_SET_SCALAR)
+		{
+			return "this CPU doesn't have AVX2";
+		}
+
+		return nullptr;
+	}
+
+	bool IsLockstepSupported(const SimulationSettings* _settings)
+	{
+		return GetLockstepUnsupportedReason(_settings) == nullptr;
+	}
+
+	void RunLockstepWorker(const SimulationSettings* _settings, std::atomic<long long>* _nextSession, RuinReport* o_report)
+	{
+		PlayLockstepSessions(_settings, _nextSession, o_report, GetSupportedInstructionSet());
+	}
+
+	/// <summary>
+	/// Check whether the exact parts of two sketches are the same.
+	/// </summary>
+	static bool DoSketchesMatch(const QuantileSketch* _a, const QuantileSketch* _b)
+	{
+		return _a->m_count == _b->m_count && _a->m_min == _b->m_min && _a->m_max == _b->m_max;
+	}
+
+	/// <summary>
+	/// Check whether two reports are the same. Round results are summed in a different order by each engine, so they only need to be close.<br>
+	/// Sessions also finish in a different order, which changes how sketches compact, so only their exact parts are compared.
+	/// </summary>
+	static bool DoReportsMatch(const RuinReport* _a, const RuinReport* _b)
+	{
+		const auto closeEnough = [](const double _x, const double _y)
+		{
+			return std::fabs(_x - _y) <= 1e-9 * (std::fabs(_x) > 1.0 ? std::fabs(_x) : 1.0);
+		};
+
+		return _a->m_sessions == _b->m_sessions && _a->m_ruined == _b->m_ruined && _a->m_rounds == _b->m_rounds &&
+			_a->m_totalFinalBank == _b->m_totalFinalBank && closeEnough(_a->m_totalResult, _b->m_totalResult) &&
+			closeEnough(_a->m_totalResultSquared, _b->m_totalResultSquared) &&
+			memcmp(_a->m_ruinRounds, _b->m_ruinRounds, sizeof(_a->m_ruinRounds)) == 0 && DoSketchesMatch(&_a->m_finalBanks, &_b->m_finalBanks) &&
+			DoSketchesMatch(&_a->m_sessionRounds, &_b->m_sessionRounds) && DoSketchesMatch(&_a->m_maxDrawdowns, &_b->m_maxDrawdowns);
+	}
+
+	/// <summary>
+	/// Play a simulation in lockstep on this thread alone, with a chosen instruction set.
+	/// </summary>
+	static void RunLockstepOnce(const SimulationSettings* _settings, const eInstructionSet _instructionSet, RuinReport* o_report)
+	{
+		ResetRuinReport(o_report, _settings);
+		std::atomic<long long> nextSession(_settings->m_firstSession);
+		PlayLockstepSessions(_settings, &nextSession, o_report, _instructionSet);
+	}
+
+	long long FindLockstepMismatch(const SimulationSettings* _settings)
+	{
+		auto settings = *_settings;
+		settings.m_threads = 1;
+		settings.m_lockstep = false;
+
+		// Reports are far too big to be kept on the stack.
+		auto* scalarReport = new RuinReport{};
+		auto* lockstepReport = new RuinReport{};
+		RunRiskOfRuin(&settings, scalarReport);
+
+		auto mismatch = -1ll;
+		for (auto instructionSet = (int)INSTRUCTION_SET_AVX2; instructionSet <= GetSupportedInstructionSet() && mismatch < 0; instructionSet++)
+		{
+			RunLockstepOnce(&settings, (eInstructionSet)instructionSet, lockstepReport);
+			if (DoReportsMatch(scalarReport, lockstepReport))
+			{
+				continue;
+			}
+
+			// Played on their own, each session's rounds are summed in the same order by both engines, so they have to match exactly.
+			auto session = settings;
+			session.m_sessions = 1;
+			for (auto sessionIndex = settings.m_firstSession; sessionIndex < settings.m_firstSession + settings.m_sessions; sessionIndex++)
+			{
+				session.m_firstSession = sessionIndex;
+				RunRiskOfRuin(&session, scalarReport);
+				RunLockstepOnce(&session, (eInstructionSet)instructionSet, lockstepReport);
+				if (!DoReportsMatch(scalarReport, lockstepReport))
+				{
+					mismatch = sessionIndex;
+					break;
+				}
+			}
+
+			// If every session matches on its own, then it's the way they're combined that doesn't.
+			if (mismatch < 0)
+			{
+				mismatch = settings.m_firstSession;
+			}
+		}
+
+		delete lockstepReport;
+		delete scalarReport;
+
+		return mismatch;
+	}
+}
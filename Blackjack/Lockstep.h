@@ -0,0 +1,62 @@
+#pragma once
+
+#ifndef LOCKSTEP_H_
+#define LOCKSTEP_H_
+
+#include <atomic>
+
+#include "Simulation.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The amount of tables a lockstep worker plays at once. AVX-512 plays them all in one register, AVX2 in two halves of eight.
+	/// </summary>
+	constexpr auto c_lockstepTables = 16;
+
+	/// <summary>
+	/// The amount of tables in one AVX2 register.
+	/// </summary>
+	constexpr auto c_lockstepTablesAVX2 = 8;
+
+	/// <summary>
+	/// The distance between each table's cards. Cards are gathered four bytes at a time, so every table has room to read past its last card.
+	/// </summary>
+	constexpr auto c_lockstepShoeStride = c_maxShoeSize + 32;
+
+	/// <summary>
+	/// Check whether a simulation can be played in lockstep.<br>
+	/// The lockstep engine doesn't export rounds, collect outcomes, play side bets, or deal from a continuous shoe or recorded shoes, and it needs at least AVX2.<br>
+	/// It also isn't used while allocations are tracked or tracepoints are enabled, since it has neither.
+	/// </summary>
+	/// <param name="_settings">The settings of the simulation.</param>
+	/// <returns>True if RunLockstepWorker can play the simulation.</returns>
+	bool IsLockstepSupported(const SimulationSettings* _settings);
+
+	/// <summary>
+	/// Find out why a simulation can't be played in lockstep, such as to tell someone why it's being skipped.
+	/// </summary>
+	/// <param name="_settings">The settings of the simulation.</param>
+	/// <returns>A short reason, ready to follow "since", or nullptr if the simulation can be played in lockstep.</returns>
+	const char* GetLockstepUnsupportedReason(const SimulationSettings* _settings);
+
+	/// <summary>
+	/// A worker thread's main function. Plays "c_lockstepTables" sessions at once, one per table, with every table's round played in lockstep.<br>
+	/// Whenever a table's session ends, the next session is started on it, so the tables stay busy until the sessions run out.<br>
+	/// Every session plays out exactly the same as it would in RunRiskOfRuin's scalar engine. The settings MUST be supported.
+	/// </summary>
+	/// <param name="_settings">The settings to play the sessions with.</param>
+	/// <param name="_nextSession">The shared counter that sessions are claimed from, in batches.</param>
+	/// <param name="o_report">The worker's own report, to add every session to.</param>
+	void RunLockstepWorker(const SimulationSettings* _settings, std::atomic<long long>* _nextSession, RuinReport* o_report);
+
+	/// <summary>
+	/// Play a simulation with both engines on one thread, and check that they give the same report.<br>
+	/// If they don't, each session is played again on its own to find the first one that plays out differently.
+	/// </summary>
+	/// <param name="_settings">The settings to play the simulation with. MUST be supported by the lockstep engine.</param>
+	/// <returns>-1 if the engines matched. Otherwise, the index of the first session that didn't.</returns>
+	long long FindLockstepMismatch(const SimulationSettings* _settings);
+}
+
+#endif
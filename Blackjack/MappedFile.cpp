@@ -0,0 +1,51 @@
+#include "MappedFile.h"
+
+#include <windows.h>
+
+namespace blackjack
+{
+	MappedFile* OpenMappedFile(const char _path[], const long long _size, const bool _writable)
+	{
+		// Other processes are allowed to write to the file as well, so that a reader and a writer can share it.
+		auto* file = CreateFileA(_path, _writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+			nullptr, _writable ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return nullptr;
+		}
+
+		LARGE_INTEGER fileSize;
+		GetFileSizeEx(file, &fileSize);
+
+		// Mapping a writable file with a larger size than it has grows the file to that size, and the new bytes are zeroed.
+		const auto size = _writable && _size > fileSize.QuadPart ? _size : fileSize.QuadPart;
+		auto* mapping = size > 0 ? CreateFileMappingA(file, nullptr, _writable ? PAGE_READWRITE : PAGE_READONLY,
+			(DWORD)(size >> 32), (DWORD)(size & 0xFFFFFFFF), nullptr) : nullptr;
+		if (mapping == nullptr)
+		{
+			CloseHandle(file);
+			return nullptr;
+		}
+
+		auto* view = MapViewOfFile(mapping, _writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return nullptr;
+		}
+
+		return new MappedFile{ file, mapping, (unsigned char*)view, size, _writable };
+	}
+
+	void CloseMappedFile(MappedFile*& _file)
+	{
+		// The view has to be unmapped before the handles it was made from are closed.
+		UnmapViewOfFile(_file->m_view);
+		CloseHandle(_file->m_mapping);
+		CloseHandle(_file->m_file);
+
+		delete _file;
+		_file = nullptr;
+	}
+}
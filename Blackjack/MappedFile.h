@@ -0,0 +1,47 @@
+#pragma once
+
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+namespace blackjack
+{
+	/// <summary>
+	/// A file on disk that has been mapped into memory, so it can be read and written like an array instead of through a stream.<br>
+	/// Every process that maps the same file sees the same memory, and the operating system only loads the pages that are touched.
+	/// </summary>
+	struct MappedFile
+	{
+		/// <summary>
+		/// The Windows handles to the open file and its mapping. These are kept as void pointers, so this header doesn't need windows.h.
+		/// </summary>
+		void* m_file;
+		void* m_mapping;
+
+		/// <summary>
+		/// The start of the mapped file. Only the first "m_size" bytes can be accessed.
+		/// </summary>
+		unsigned char* m_view;
+		long long m_size;
+
+		bool m_writable;
+	};
+
+	/// <summary>
+	/// Open a file and map the whole of it into memory.<br>
+	/// If the file is writable, it is created if it doesn't exist, and grown with zeroes if it's smaller than the size asked for.
+	/// </summary>
+	/// <param name="_path">The path of the file.</param>
+	/// <param name="_size">The least amount of bytes the file should have. Files opened read-only are mapped at whatever size they are, so this can be 0.</param>
+	/// <param name="_writable">Whether the mapping can be written to. Read-only files can be shared with any amount of other processes.</param>
+	/// <returns>A pointer to the mapped file in memory, or nullptr if it couldn't be opened, is empty, or couldn't be grown.</returns>
+	MappedFile* OpenMappedFile(const char _path[], long long _size, bool _writable);
+
+	/// <summary>
+	/// Unmap a file and close it, then free the memory allocated to it and nullify its pointer.<br>
+	/// Anything written to the mapping is written back to the file by the operating system, even if the program closes later on.
+	/// </summary>
+	/// <param name="_file">The file to be closed.</param>
+	void CloseMappedFile(MappedFile*& _file);
+}
+
+#endif
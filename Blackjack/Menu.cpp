@@ -4,6 +4,8 @@
 
 #include "Game.h"
 #include "IO.h"
+#include "Optimiser.h"
+#include "Simulation.h"
 
 namespace blackjack
 {
@@ -15,8 +17,8 @@ namespace blackjack
 			// Execute a system instruction to clear the console.
 			// This isn't recommended for plenty of reasons, but it's easy and simple for our specific purposes.
 			system("CLS");
-			std::cout << "Options:\n(1) - New Game\n(2) - Debug Mode\n(3) - Quit\n";
-			const auto playerInput = GetOption(3);
+			std::cout << "Options:\n(1) - New Game\n(2) - Debug Mode\n(3) - Risk of Ruin Simulation\n(4) - Optimise Policy\n(5) - Quit\n";
+			const auto playerInput = GetOption(5);
 			
 			switch(playerInput)
 			{
@@ -37,7 +39,21 @@ namespace blackjack
 				}
 				case 3:
 				{
-					// Quit: 3 disables the while loop, ending the program.
+					// The simulation asks for its own settings, and waits for the user before returning.
+					RiskOfRuinMenu();
+
+					break;
+				}
+				case 4:
+				{
+					// The optimiser asks for its own settings too, and also waits for the user before returning.
+					OptimiserMenu();
+
+					break;
+				}
+				case 5:
+				{
+					// Quit: 5 disables the while loop, ending the program.
 					running = false;
 						
 					break;
@@ -10,7 +10,7 @@ namespace blackjack
 {
 	/// <summary>
 	/// Primary landing function for the program.<br>
-	/// Handles menu options (Play, Debug, Quit) for a controlled entrance / exit.
+	/// Handles menu options (Play, Debug, Simulation, Quit) for a controlled entrance / exit.
 	/// </summary>
 	void MenuLoop();
 }
@@ -0,0 +1,297 @@
+#include "Optimiser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "IO.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// Get the amount of values a parameter takes, which is 1 if it isn't being searched.
+	/// </summary>
+	static int GetParameterValueCount(const OptimiserSettings* _settings, const int _parameter)
+	{
+		const auto& range = c_parameterRanges[_parameter];
+		return _settings->m_searched[_parameter] ? (range.m_max - range.m_min) / range.m_step + 1 : 1;
+	}
+
+	int GetCandidateCount(const OptimiserSettings* _settings)
+	{
+		auto count = 1;
+		for (auto parameter = 0; parameter < TOTAL_OPTIMISER_PARAMETERS; parameter++)
+		{
+			count *= GetParameterValueCount(_settings, parameter);
+		}
+		return count;
+	}
+
+	void FillCandidateGrid(const OptimiserSettings* _settings, OptimiserCandidate o_candidates[])
+	{
+		const auto count = GetCandidateCount(_settings);
+		for (auto candidateIndex = 0; candidateIndex < count; candidateIndex++)
+		{
+			auto& candidate = o_candidates[candidateIndex];
+			candidate = OptimiserCandidate{};
+
+			// The index is read as a number where each digit is one parameter's value, with as many values per digit as that parameter has.
+			auto remainder = candidateIndex;
+			for (auto parameter = 0; parameter < TOTAL_OPTIMISER_PARAMETERS; parameter++)
+			{
+				const auto& range = c_parameterRanges[parameter];
+				if (!_settings->m_searched[parameter])
+				{
+					candidate.m_values[parameter] = range.m_default;
+					continue;
+				}
+
+				const auto valueCount = GetParameterValueCount(_settings, parameter);
+				candidate.m_values[parameter] = range.m_min + remainder % valueCount * range.m_step;
+				remainder /= valueCount;
+			}
+		}
+	}
+
+	void ApplyCandidate(const OptimiserCandidate* _candidate, SimulationSettings* o_settings)
+	{
+		o_settings->m_basicStrategy = false;
+		o_settings->m_standThreshold = _candidate->m_values[OPTIMISER_PARAMETER_STAND_THRESHOLD];
+
+		// The ramp is one base bet until its start, then climbs by its slope for every true count after. The max bet still caps it.
+		const auto rampStart = _candidate->m_values[OPTIMISER_PARAMETER_RAMP_START];
+		const auto rampSlope = _candidate->m_values[OPTIMISER_PARAMETER_RAMP_SLOPE];
+		o_settings->m_betPolicy.m_type = BET_POLICY_COUNT_SPREAD;
+		for (auto step = 0; step <= c_spreadSteps; step++)
+		{
+			o_settings->m_betPolicy.m_spread[step] = step < rampStart ? 1 : rampSlope * (step - rampStart + 1);
+		}
+
+		// Stops are measured from the starting money, so that 0% of it is never a stop at all.
+		const auto stopWin = _candidate->m_values[OPTIMISER_PARAMETER_STOP_WIN];
+		const auto stopLoss = _candidate->m_values[OPTIMISER_PARAMETER_STOP_LOSS];
+		o_settings->m_stopWin = stopWin > 0 ? o_settings->m_startingBank * (100 + stopWin) / 100 : 0;
+		o_settings->m_stopLoss = stopLoss > 0 ? o_settings->m_startingBank * (100 - stopLoss) / 100 : 0;
+	}
+
+	double GetCandidateScore(const OptimiserCandidate* _candidate)
+	{
+		return _candidate->m_sessions > 0 ? (double)_candidate->m_totalProfit / (double)_candidate->m_sessions : 0.0;
+	}
+
+	/// <summary>
+	/// A worker thread's main function. Claims candidates one at a time until there are none left, simulating each on this thread alone.
+	/// </summary>
+	static void RunOptimiserWorker(const SimulationSettings* _simulation, OptimiserCandidate _candidates[], const int _count,
+		const long long _sessions, std::atomic<int>* _nextCandidate)
+	{
+		// The report is far too big to be kept on the stack, so each worker keeps one in the heap for every candidate it claims.
+		auto* report = new RuinReport{};
+
+		auto candidateIndex = _nextCandidate->fetch_add(1);
+		while (candidateIndex < _count)
+		{
+			auto& candidate = _candidates[candidateIndex];
+			if (candidate.m_sessions < _sessions)
+			{
+				// Sessions are seeded by their index, so carrying on from the last session simulated is just like simulating them all again.
+				auto settings = *_simulation;
+				ApplyCandidate(&candidate, &settings);
+				settings.m_firstSession = _simulation->m_firstSession + candidate.m_sessions;
+				settings.m_sessions = _sessions - candidate.m_sessions;
+				settings.m_threads = 1;
+				settings.m_collectOutcomes = false;
+				settings.m_exportFormat = EXPORT_FORMAT_NONE;
+
+				RunRiskOfRuin(&settings, report);
+
+				candidate.m_sessions += report->m_sessions;
+				candidate.m_ruined += report->m_ruined;
+				candidate.m_rounds += report->m_rounds;
+				candidate.m_totalProfit += report->m_totalFinalBank - report->m_sessions * settings.m_startingBank;
+			}
+
+			candidateIndex = _nextCandidate->fetch_add(1);
+		}
+
+		delete report;
+	}
+
+	void EvaluateCandidates(const SimulationSettings* _simulation, OptimiserCandidate _candidates[], const int _count, const long long _sessions, const int _threads)
+	{
+		auto threadCount = _threads > 0 ? _threads : (int)std::thread::hardware_concurrency();
+		if (threadCount < 1)
+		{
+			threadCount = 1;
+		}
+
+		// Candidates are spread across threads rather than sessions, since there are usually far more candidates than threads.
+		auto* threads = new std::thread[threadCount];
+		std::atomic<int> nextCandidate(0);
+
+		for (auto threadIndex = 0; threadIndex < threadCount; threadIndex++)
+		{
+			threads[threadIndex] = std::thread(RunOptimiserWorker, _simulation, _candidates, _count, _sessions, &nextCandidate);
+		}
+
+		for (auto threadIndex = 0; threadIndex < threadCount; threadIndex++)
+		{
+			threads[threadIndex].join();
+		}
+
+		delete[] threads;
+	}
+
+	/// <summary>
+	/// Sort candidates from the best score to the worst.
+	/// </summary>
+	static void SortCandidates(OptimiserCandidate _candidates[], const int _count)
+	{
+		std::sort(_candidates, _candidates + _count, [](const OptimiserCandidate& _a, const OptimiserCandidate& _b)
+		{
+			return GetCandidateScore(&_a) > GetCandidateScore(&_b);
+		});
+	}
+
+	int RunOptimiser(const OptimiserSettings* _settings, OptimiserCandidate o_candidates[])
+	{
+		const auto count = GetCandidateCount(_settings);
+		FillCandidateGrid(_settings, o_candidates);
+
+		if (_settings->m_method == SEARCH_METHOD_GRID)
+		{
+			EvaluateCandidates(&_settings->m_simulation, o_candidates, count, _settings->m_sessions, _settings->m_threads);
+			SortCandidates(o_candidates, count);
+			return count;
+		}
+
+		// Every round, the better half of the candidates are kept at the front and simulated with twice as many sessions.
+		// Culled candidates stay behind them, sorted by how they did in the round they were culled in.
+		auto remaining = count;
+		auto sessions = _settings->m_sessions;
+		for (auto round = 1; ; round++)
+		{
+			std::cout << "Round " << round << ": " << remaining << " candidates, " << sessions << " sessions each\n" << std::flush;
+
+			EvaluateCandidates(&_settings->m_simulation, o_candidates, remaining, sessions, _settings->m_threads);
+			SortCandidates(o_candidates, remaining);
+
+			if (remaining <= 1)
+			{
+				return remaining;
+			}
+
+			remaining = (remaining + 1) / 2;
+			sessions *= 2;
+		}
+	}
+
+	/// <summary>
+	/// Display the best candidates of a search, with only the parameters that were searched.
+	/// </summary>
+	static void DisplayCandidates(const OptimiserSettings* _settings, const OptimiserCandidate _candidates[], const int _count)
+	{
+		for (auto parameter = 0; parameter < TOTAL_OPTIMISER_PARAMETERS; parameter++)
+		{
+			if (_settings->m_searched[parameter])
+			{
+				std::cout << std::setw(17) << c_optimiserParameterNames[parameter];
+			}
+		}
+		std::cout << std::setw(12) << "Sessions" << std::setw(20) << "Session Profit (\x9C)" << std::setw(14) << "Risk of Ruin" << "\n";
+
+		std::cout << std::fixed << std::setprecision(2);
+		for (auto candidateIndex = 0; candidateIndex < _count && candidateIndex < c_displayedCandidates; candidateIndex++)
+		{
+			const auto& candidate = _candidates[candidateIndex];
+			for (auto parameter = 0; parameter < TOTAL_OPTIMISER_PARAMETERS; parameter++)
+			{
+				if (_settings->m_searched[parameter])
+				{
+					std::cout << std::setw(17) << candidate.m_values[parameter];
+				}
+			}
+
+			std::cout << std::setw(12) << candidate.m_sessions << std::setw(20) << GetCandidateScore(&candidate) << std::setw(13) <<
+				100.0 * (double)candidate.m_ruined / (double)(candidate.m_sessions > 0 ? candidate.m_sessions : 1) << "%\n";
+		}
+		std::cout << "\n";
+	}
+
+	void OptimiserMenu()
+	{
+		OptimiserSettings settings{};
+		settings.m_simulation = SimulationSettings{ 1, false, 11, 17, false, {}, {}, c_startingBank, 1, 0, 0, 0, 1, 0, true, 0, false, EXPORT_FORMAT_NONE, {}, {} };
+
+		system("CLS");
+		std::cout << "How should the parameters be searched?\nOptions:\n";
+		for (auto methodIndex = 0; methodIndex < TOTAL_SEARCH_METHODS; methodIndex++)
+		{
+			std::cout << "(" << methodIndex + 1 << ") - " << c_searchMethodNames[methodIndex] << "\n";
+		}
+		settings.m_method = (eSearchMethod)(GetOption(TOTAL_SEARCH_METHODS) - 1);
+
+		for (auto parameter = 0; parameter < TOTAL_OPTIMISER_PARAMETERS; parameter++)
+		{
+			const auto& range = c_parameterRanges[parameter];
+			std::cout << "\nShould the " << c_optimiserParameterNames[parameter] << " be searched? (" << range.m_min << " to " << range.m_max <<
+				" in steps of " << range.m_step << ", otherwise " << range.m_default << ")\n(1) - Yes\n(2) - No\n";
+			settings.m_searched[parameter] = GetOption(2) == 1;
+		}
+
+		if (settings.m_method == SEARCH_METHOD_GRID)
+		{
+			std::cout << "\nHow many sessions should every candidate be simulated with? (In thousands)\n";
+		}
+		else
+		{
+			std::cout << "\nHow many sessions should every candidate start with? (In thousands)\n";
+		}
+		settings.m_sessions = GetInput(1000000, "a session count", "", " thousand", "") * 1000ll;
+
+		std::cout << "\nWhat is the smallest bet? (Starting Money: \x9C" << c_startingBank << ")\n";
+		const auto baseBet = GetBet(c_startingBank);
+
+		std::cout << "\nWhat is the largest bet? (Anything below \x9C" << baseBet << " is raised to it)\n";
+		const auto maxBet = GetBet(c_startingBank * 10);
+		settings.m_simulation.m_betPolicy = GetDefaultBetPolicy(BET_POLICY_COUNT_SPREAD, baseBet, maxBet);
+
+		std::cout << "\nHow many rounds can a session last before it is stopped?\n";
+		settings.m_simulation.m_maxRounds = GetInput(1000000, "a round limit", "", "", "");
+
+		std::cout << "\nHow many decks should be in the shoe?\n";
+		settings.m_simulation.m_decks = GetInput(c_maxShoeDecks, "a deck count", "", "", "");
+
+		// Just like the game itself, the search follows the seed set in main.
+		settings.m_simulation.m_seed = (unsigned long long)rand() << 32 | (unsigned long long)rand();
+
+		const auto count = GetCandidateCount(&settings);
+		std::cout << "\nSearching " << count << " candidates...\n" << std::flush;
+
+		const auto start = std::chrono::steady_clock::now();
+
+		auto* candidates = new OptimiserCandidate[count];
+		const auto remaining = RunOptimiser(&settings, candidates);
+
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		long long rounds = 0;
+		for (auto candidateIndex = 0; candidateIndex < count; candidateIndex++)
+		{
+			rounds += candidates[candidateIndex].m_rounds;
+		}
+
+		system("CLS");
+		std::cout << c_searchMethodNames[settings.m_method] << ": " << count << " candidates, " << remaining << " lasted until the end.\n\n";
+		DisplayCandidates(&settings, candidates, count);
+
+		std::cout << "Searched in " << std::fixed << std::setprecision(2) << elapsed.count() << " seconds (" <<
+			std::setprecision(0) << (double)rounds / elapsed.count() << " rounds per second).\n\n" << std::flush;
+
+		delete[] candidates;
+		system("PAUSE");
+	}
+}
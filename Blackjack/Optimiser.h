@@ -0,0 +1,180 @@
+#pragma once
+
+#ifndef OPTIMISER_H_
+#define OPTIMISER_H_
+
+#include "Simulation.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// Every policy parameter the optimiser can search.<br>
+	/// Includes a value to refer to for the total amount of parameters, which should not be used as a parameter ever.
+	/// </summary>
+	enum eOptimiserParameter : int
+	{
+		OPTIMISER_PARAMETER_STAND_THRESHOLD = 0,
+		OPTIMISER_PARAMETER_RAMP_START,
+		OPTIMISER_PARAMETER_RAMP_SLOPE,
+		OPTIMISER_PARAMETER_STOP_WIN,
+		OPTIMISER_PARAMETER_STOP_LOSS,
+		TOTAL_OPTIMISER_PARAMETERS
+	};
+
+	/// <summary>
+	/// String values for every parameter name.<br>
+	/// Includes an additional blank value for the TOTAL_OPTIMISER_PARAMETERS value.
+	/// </summary>
+	constexpr char c_optimiserParameterNames[][16] = { "Stand Threshold", "Ramp Start", "Ramp Slope", "Stop Win %", "Stop Loss %", "" };
+
+	/// <summary>
+	/// Every value a parameter can be searched over, from the minimum to the maximum (inclusive) in steps.<br>
+	/// The default is what the parameter is fixed at when it isn't being searched.
+	/// </summary>
+	struct ParameterRange
+	{
+		int m_min;
+		int m_max;
+		int m_step;
+		int m_default;
+	};
+
+	/// <summary>
+	/// The range of every parameter, in the same order as eOptimiserParameter.<br>
+	/// The stand threshold is the same as the simulation's. The ramp bets one base bet below the start's true count, then "slope" base bets
+	/// more for every true count from the start onwards. Stops are a percentage of the starting money won or lost, where 0 never stops.
+	/// </summary>
+	constexpr ParameterRange c_parameterRanges[] = { { 12, 21, 1, 17 }, { 1, c_spreadSteps, 1, 2 }, { 1, 8, 1, 2 }, { 0, 200, 25, 0 }, { 0, 75, 25, 0 } };
+	static_assert(sizeof(c_parameterRanges) / sizeof(c_parameterRanges[0]) == TOTAL_OPTIMISER_PARAMETERS, "Every parameter needs a range.");
+
+	/// <summary>
+	/// The amount of candidates displayed once the search is finished, best first.
+	/// </summary>
+	constexpr auto c_displayedCandidates = 10;
+
+	/// <summary>
+	/// Every way the optimiser can search.<br>
+	/// Includes a value to refer to for the total amount of methods, which should not be used as a method ever.
+	/// </summary>
+	enum eSearchMethod : int
+	{
+		/// <summary>
+		/// Every candidate is simulated with the full amount of sessions.
+		/// </summary>
+		SEARCH_METHOD_GRID = 0,
+
+		/// <summary>
+		/// Every candidate is simulated with a few sessions, then the worse half is culled and the rest get twice as many, until one is left.
+		/// </summary>
+		SEARCH_METHOD_SUCCESSIVE_HALVING,
+		TOTAL_SEARCH_METHODS
+	};
+
+	/// <summary>
+	/// String values for every search method name.<br>
+	/// Includes an additional blank value for the TOTAL_SEARCH_METHODS value.
+	/// </summary>
+	constexpr char c_searchMethodNames[][20] = { "Grid Search", "Successive Halving", "" };
+
+	/// <summary>
+	/// One combination of parameter values, and the combined results of every session it has been simulated with so far.
+	/// </summary>
+	struct OptimiserCandidate
+	{
+		int m_values[TOTAL_OPTIMISER_PARAMETERS];
+
+		long long m_sessions;
+		long long m_ruined;
+		long long m_rounds;
+
+		/// <summary>
+		/// The sum of every session's final bank minus the starting money.
+		/// </summary>
+		long long m_totalProfit;
+	};
+
+	/// <summary>
+	/// Everything needed to describe a search.
+	/// </summary>
+	struct OptimiserSettings
+	{
+		/// <summary>
+		/// The simulation every candidate is applied to. The candidate's parameters override its strategy, bet policy, and stops.<br>
+		/// Every candidate is given the same seed, so they're all compared over the same shoes.
+		/// </summary>
+		SimulationSettings m_simulation;
+
+		eSearchMethod m_method;
+
+		/// <summary>
+		/// Which parameters are searched. The rest are fixed at their default.
+		/// </summary>
+		bool m_searched[TOTAL_OPTIMISER_PARAMETERS];
+
+		/// <summary>
+		/// The amount of sessions each candidate is simulated with, or for successive halving, the amount in the first round.
+		/// </summary>
+		long long m_sessions;
+
+		/// <summary>
+		/// The amount of worker threads. 0 uses one per hardware thread.
+		/// </summary>
+		int m_threads;
+	};
+
+	/// <summary>
+	/// Get the amount of candidates a search starts with, which is every combination of the searched parameters' values.
+	/// </summary>
+	/// <param name="_settings">The settings of the search.</param>
+	/// <returns>The amount of candidates.</returns>
+	int GetCandidateCount(const OptimiserSettings* _settings);
+
+	/// <summary>
+	/// Fill an array with every combination of the searched parameters' values, none of which have been simulated yet.
+	/// </summary>
+	/// <param name="_settings">The settings of the search.</param>
+	/// <param name="o_candidates">The array to be filled. MUST have room for GetCandidateCount candidates.</param>
+	void FillCandidateGrid(const OptimiserSettings* _settings, OptimiserCandidate o_candidates[]);
+
+	/// <summary>
+	/// Override a simulation's strategy, bet policy, and stops with a candidate's parameters.<br>
+	/// The player always hits until the stand threshold, and always bets with a count spread.
+	/// </summary>
+	/// <param name="_candidate">The candidate to apply.</param>
+	/// <param name="o_settings">The settings to be overridden.</param>
+	void ApplyCandidate(const OptimiserCandidate* _candidate, SimulationSettings* o_settings);
+
+	/// <summary>
+	/// Get how good a candidate is, which is how much money it's expected to win (or lose) over a whole session.
+	/// </summary>
+	/// <param name="_candidate">The candidate to score.</param>
+	/// <returns>The expected profit of a session, or 0 if the candidate hasn't been simulated.</returns>
+	double GetCandidateScore(const OptimiserCandidate* _candidate);
+
+	/// <summary>
+	/// Simulate every candidate until it has been simulated with a certain amount of sessions, in parallel.<br>
+	/// Only the sessions a candidate is missing are simulated, so it carries on from wherever it had been simulated up to.
+	/// </summary>
+	/// <param name="_simulation">The simulation every candidate is applied to.</param>
+	/// <param name="_candidates">The candidates to simulate.</param>
+	/// <param name="_count">The amount of candidates.</param>
+	/// <param name="_sessions">The amount of sessions every candidate should have been simulated with afterwards.</param>
+	/// <param name="_threads">The amount of worker threads. 0 uses one per hardware thread.</param>
+	void EvaluateCandidates(const SimulationSettings* _simulation, OptimiserCandidate _candidates[], int _count, long long _sessions, int _threads);
+
+	/// <summary>
+	/// Search every combination of the searched parameters, then sort them from best to worst.<br>
+	/// For successive halving, candidates that were culled earlier are sorted after every one that lasted longer.
+	/// </summary>
+	/// <param name="_settings">The settings of the search.</param>
+	/// <param name="o_candidates">The array to be searched. MUST have room for GetCandidateCount candidates.</param>
+	/// <returns>The amount of candidates that lasted until the end of the search.</returns>
+	int RunOptimiser(const OptimiserSettings* _settings, OptimiserCandidate o_candidates[]);
+
+	/// <summary>
+	/// Ask the user for the settings of a search, run it, and display the best candidates.
+	/// </summary>
+	void OptimiserMenu();
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "PackedHand.h"
+
+namespace blackjack
+{
+	constexpr auto c_packedAceShift = 8;
+	constexpr auto c_packedSizeShift = 13;
+	constexpr PackedHand c_packedValueMask = 0xFF;
+	constexpr PackedHand c_packedFieldMask = 0x1F;
+
+	static_assert(c_maxHandSize * 10 <= (int)c_packedValueMask && c_maxHandSize <= (int)c_packedFieldMask, "A full hand has to fit in every field.");
+
+	/// <summary>
+	/// What each card adds to a packed hand, by whether it's face-up and then by its rank.
+	/// </summary>
+	constexpr PackedHand c_packedCardDeltas[2][TOTAL_RANKS] =
+	{
+		{
+			1 << c_packedSizeShift, 1 << c_packedSizeShift, 1 << c_packedSizeShift, 1 << c_packedSizeShift, 1 << c_packedSizeShift,
+			1 << c_packedSizeShift, 1 << c_packedSizeShift, 1 << c_packedSizeShift, 1 << c_packedSizeShift, 1 << c_packedSizeShift,
+			1 << c_packedSizeShift, 1 << c_packedSizeShift, 1 << c_packedSizeShift
+		},
+		{
+			(1 << c_packedSizeShift) + (1 << c_packedAceShift), (1 << c_packedSizeShift) + 2, (1 << c_packedSizeShift) + 3,
+			(1 << c_packedSizeShift) + 4, (1 << c_packedSizeShift) + 5, (1 << c_packedSizeShift) + 6, (1 << c_packedSizeShift) + 7,
+			(1 << c_packedSizeShift) + 8, (1 << c_packedSizeShift) + 9, (1 << c_packedSizeShift) + 10, (1 << c_packedSizeShift) + 10,
+			(1 << c_packedSizeShift) + 10, (1 << c_packedSizeShift) + 10
+		}
+	};
+
+	/// <summary>
+	/// What the player gets back for each result, in halves of their bet.
+	/// </summary>
+	constexpr int c_payoutHalves[] = { 0, 2, 4, 5 };
+
+	/// <summary>
+	/// Rank a packed hand, so that comparing two hands is only comparing their scores.<br>
+	/// A bust hand scores 0, a valid hand scores its value + 1 (so even an empty hand beats a bust one), and a natural scores highest of all.
+	/// </summary>
+	static int GetPackedHandScore(const PackedHand _hand, const int _aceValue)
+	{
+		const auto value = GetPackedHandValue(_hand, _aceValue);
+		return (value <= 21) * (value + 1 + (value == 21 && (_hand >> c_packedSizeShift & c_packedFieldMask) == 2));
+	}
+
+	PackedHand AddPackedCard(const PackedHand _hand, const Card* _card)
+	{
+		return _hand + c_packedCardDeltas[_card->m_visible][_card->m_rank];
+	}
+
+	PackedHand PackHand(const Hand* _hand)
+	{
+		auto packed = c_emptyPackedHand;
+		for (auto cardIndex = 0; cardIndex < _hand->m_size; cardIndex++)
+		{
+			packed = AddPackedCard(packed, &_hand->m_cards[cardIndex]);
+		}
+
+		return packed;
+	}
+
+	int GetPackedHandValue(const PackedHand _hand, const int _aceValue)
+	{
+		return (int)(_hand & c_packedValueMask) + (int)(_hand >> c_packedAceShift & c_packedFieldMask) * _aceValue;
+	}
+
+	eHandValidity GetPackedHandValidity(const PackedHand _hand, const int _aceValue)
+	{
+		const auto value = GetPackedHandValue(_hand, _aceValue);
+		return (eHandValidity)((value <= 21) + (value == 21 && (_hand >> c_packedSizeShift & c_packedFieldMask) == 2));
+	}
+
+	eHandValidityComparison ComparePackedHands(const PackedHand _handA, const PackedHand _handB, const int _aceValue)
+	{
+		const auto scoreA = GetPackedHandScore(_handA, _aceValue);
+		const auto scoreB = GetPackedHandScore(_handB, _aceValue);
+
+		// Two bust hands tie, just like any other two equal scores. A hand only wins with a natural if it beats the other hand.
+		if (scoreA == scoreB)
+		{
+			return HAND_COMPARISON_TIE;
+		}
+
+		return scoreA < scoreB ? HAND_COMPARISON_LOSS : scoreA == 23 ? HAND_COMPARISON_NATURAL : HAND_COMPARISON_WIN;
+	}
+
+	int GetPackedPayout(const eHandValidityComparison _result, const int _bet)
+	{
+		return _bet * c_payoutHalves[_result] / 2;
+	}
+}
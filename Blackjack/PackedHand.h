@@ -0,0 +1,77 @@
+#pragma once
+
+#ifndef PACKED_HAND_H_
+#define PACKED_HAND_H_
+
+#include "Hand.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// A hand's value packed into a single integer, which is kept up to date as each card is added instead of being summed whenever it's read.<br>
+	/// Bits 0-7 hold the value of every face-up card that isn't an Ace, bits 8-12 the amount of face-up Aces, and bits 13-17 the amount of cards.<br>
+	/// Each field is wide enough for a full hand of "c_maxHandSize" cards, even one of all Tens.<br>
+	/// Aces are only counted, so the same packed hand can be read with either ace value.
+	/// </summary>
+	using PackedHand = unsigned int;
+
+	/// <summary>
+	/// A hand without any cards in it.
+	/// </summary>
+	constexpr PackedHand c_emptyPackedHand = 0;
+
+	/// <summary>
+	/// The largest bet GetPackedPayout is exact for. GetPayout works with floats, which can't hold every half above 2^23.
+	/// </summary>
+	constexpr auto c_maxPackedPayoutBet = 1 << 21;
+
+	/// <summary>
+	/// Add a card into a packed hand. This is a single addition, of a value read from a table.
+	/// </summary>
+	/// <param name="_hand">The packed hand.</param>
+	/// <param name="_card">The card to be added. Face-down cards only add to the amount of cards.</param>
+	/// <returns>The packed hand with the card added.</returns>
+	PackedHand AddPackedCard(PackedHand _hand, const Card* _card);
+
+	/// <summary>
+	/// Pack every card in a hand.
+	/// </summary>
+	/// <param name="_hand">The hand to be packed.</param>
+	/// <returns>The packed hand.</returns>
+	PackedHand PackHand(const Hand* _hand);
+
+	/// <summary>
+	/// The same as GetTotalHandValue, for a packed hand.
+	/// </summary>
+	/// <param name="_hand">The packed hand.</param>
+	/// <param name="_aceValue">The integer value of Aces (should be 1 or 11).</param>
+	/// <returns>The total value of every face-up card.</returns>
+	int GetPackedHandValue(PackedHand _hand, int _aceValue);
+
+	/// <summary>
+	/// The same as IsHandValid, for a packed hand.
+	/// </summary>
+	/// <param name="_hand">The packed hand.</param>
+	/// <param name="_aceValue">The integer value of Aces (should be 1 or 11).</param>
+	/// <returns>Whether the hand is bust, valid, or a natural.</returns>
+	eHandValidity GetPackedHandValidity(PackedHand _hand, int _aceValue);
+
+	/// <summary>
+	/// The same as CompareHands, for packed hands. Each hand is ranked by a single score, so the comparison is just the two scores.
+	/// </summary>
+	/// <param name="_handA">The packed hand being compared.</param>
+	/// <param name="_handB">The packed hand being compared against.</param>
+	/// <param name="_aceValue">The integer value of Aces (should be 1 or 11).</param>
+	/// <returns>The result of hand A against hand B.</returns>
+	eHandValidityComparison ComparePackedHands(PackedHand _handA, PackedHand _handB, int _aceValue);
+
+	/// <summary>
+	/// The same as GetPayout, using only whole numbers. Matches GetPayout exactly for any bet up to "c_maxPackedPayoutBet".
+	/// </summary>
+	/// <param name="_result">The player's hand compared to the dealer's.</param>
+	/// <param name="_bet">The amount of money the player bet.</param>
+	/// <returns>The total amount paid back, including the original bet. 0 if the player lost.</returns>
+	int GetPackedPayout(eHandValidityComparison _result, int _bet);
+}
+
+#endif
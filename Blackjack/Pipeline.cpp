@@ -0,0 +1,78 @@
+#include "Pipeline.h"
+
+#include <chrono>
+
+namespace blackjack
+{
+	/// <summary>
+	/// The producer thread's main function. Keeps the ring topped up until the pipeline is destroyed.
+	/// </summary>
+	/// <param name="_pipeline">The pipeline to fill.</param>
+	static void ProduceShuffleOrders(ShufflePipeline* _pipeline)
+	{
+		while (_pipeline->m_running.load(std::memory_order_relaxed))
+		{
+			const auto tail = _pipeline->m_tail.load(std::memory_order_relaxed);
+
+			// If the ring is full then the game hasn't needed a reshuffle in a while. There's no point spinning, so take a nap.
+			if (tail - _pipeline->m_head.load(std::memory_order_acquire) == c_shuffleRingSize)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				continue;
+			}
+
+			GenerateShuffleOrder(&_pipeline->m_orders[tail & (c_shuffleRingSize - 1)], &_pipeline->m_random);
+
+			// The release store makes sure the game can't see the new tail before it can see the finished order.
+			_pipeline->m_tail.store(tail + 1, std::memory_order_release);
+		}
+	}
+
+	ShufflePipeline* CreateShufflePipeline(const unsigned long long _seed)
+	{
+		auto* pipeline = new ShufflePipeline{};
+
+		SeedBatchRandom(&pipeline->m_random, _seed);
+		pipeline->m_head.store(0);
+		pipeline->m_tail.store(0);
+		pipeline->m_running.store(true);
+
+		// The thread must only be started once everything else is set up, since it starts reading straight away.
+		pipeline->m_producer = std::thread(ProduceShuffleOrders, pipeline);
+
+		return pipeline;
+	}
+
+	void DestroyShufflePipeline(ShufflePipeline*& _pipeline)
+	{
+		// The producer must have finished BEFORE the memory it's writing to is freed.
+		_pipeline->m_running.store(false);
+		_pipeline->m_producer.join();
+
+		delete _pipeline;
+		_pipeline = nullptr;
+	}
+
+	const ShuffleOrder* PeekShuffleOrder(ShufflePipeline* _pipeline)
+	{
+		const auto head = _pipeline->m_head.load(std::memory_order_relaxed);
+
+		// The ring is empty. The caller will just have to shuffle the slow way this time.
+		if (head == _pipeline->m_tail.load(std::memory_order_acquire))
+		{
+			return nullptr;
+		}
+
+		return &_pipeline->m_orders[head & (c_shuffleRingSize - 1)];
+	}
+
+	void ReleaseShuffleOrder(ShufflePipeline* _pipeline)
+	{
+		_pipeline->m_head.store(_pipeline->m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	void GenerateShuffleOrder(ShuffleOrder* _order, BatchRandom* _random)
+	{
+		GenerateShuffleSwaps(_random, _order->m_swaps, c_maxShoeSize);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#ifndef PIPELINE_H_
+#define PIPELINE_H_
+
+#include <atomic>
+#include <thread>
+
+#include "BatchRandom.h"
+#include "Shoe.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// How many shuffled orders the pipeline keeps ready ahead of time. MUST be a power of two.
+	/// </summary>
+	constexpr auto c_shuffleRingSize = 8;
+
+	/// <summary>
+	/// Pre-generated Fisher-Yates swap targets for a full shoe, where m_swaps[i] is a random position from 0 to i (inclusive).<br>
+	/// Every target is independent of the others, so the first N of them will shuffle a discard pile of any size N.
+	/// </summary>
+	struct ShuffleOrder
+	{
+		unsigned short m_swaps[c_maxShoeSize];
+	};
+
+	/// <summary>
+	/// A producer thread that shuffles orders ahead of time, and a bounded lock-free ring to hand them to the game.<br>
+	/// There must only ever be one thread taking orders out of the ring (the game), and one putting them in (the producer).
+	/// </summary>
+	struct ShufflePipeline
+	{
+		ShuffleOrder m_orders[c_shuffleRingSize];
+
+		/// <summary>
+		/// The next order to be taken by the game. Only ever written by the game.
+		/// </summary>
+		std::atomic<unsigned> m_head;
+
+		/// <summary>
+		/// The next order to be filled by the producer. Only ever written by the producer.
+		/// </summary>
+		std::atomic<unsigned> m_tail;
+
+		/// <summary>
+		/// Cleared when the pipeline is destroyed, to tell the producer to stop.
+		/// </summary>
+		std::atomic<bool> m_running;
+
+		/// <summary>
+		/// The producer's own generator. rand() is shared between threads, so it can't be used here.
+		/// </summary>
+		BatchRandom m_random;
+
+		std::thread m_producer;
+	};
+
+	/// <summary>
+	/// Allocate memory to and create a new shuffle pipeline in the heap, and start its producer thread.
+	/// </summary>
+	/// <param name="_seed">The seed for the producer's random number generator.</param>
+	/// <returns>A pointer to the created pipeline in memory.</returns>
+	ShufflePipeline* CreateShufflePipeline(unsigned long long _seed);
+
+	/// <summary>
+	/// Stop the producer thread, then free the memory allocated to a pipeline and nullify its pointer.
+	/// </summary>
+	/// <param name="_pipeline">The pipeline to be de-allocated.</param>
+	void DestroyShufflePipeline(ShufflePipeline*& _pipeline);
+
+	/// <summary>
+	/// Get the oldest shuffled order that is ready, without waiting. It stays valid until ReleaseShuffleOrder is called.
+	/// </summary>
+	/// <param name="_pipeline">The pipeline to take an order from.</param>
+	/// <returns>A pointer to the ready order, or nullptr if the producer hasn't caught up yet.</returns>
+	const ShuffleOrder* PeekShuffleOrder(ShufflePipeline* _pipeline);
+
+	/// <summary>
+	/// Hand the order returned by PeekShuffleOrder back to the producer, so that it can be re-shuffled.
+	/// </summary>
+	/// <param name="_pipeline">The pipeline the order was taken from.</param>
+	void ReleaseShuffleOrder(ShufflePipeline* _pipeline);
+
+	/// <summary>
+	/// Fill an order with new random swap targets.
+	/// </summary>
+	/// <param name="_order">The order to be filled.</param>
+	/// <param name="_random">The generator to shuffle with.</param>
+	void GenerateShuffleOrder(ShuffleOrder* _order, BatchRandom* _random);
+}
+
+#endif
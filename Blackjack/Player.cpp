@@ -1,23 +1,37 @@
 #include "Player.h"
 
+#include <malloc.h>
+#include <new>
+
+#include "AllocationTracker.h"
+
 namespace blackjack
 {
 	Player* CreatePlayer(const int _startingBank)
 	{
-		// Player hands are stored using the deck struct. Yes, this is kind of confusing terminology.
-		// A possible alternative could be renaming Deck to CardPool or something, but there's no need.
-		// I know that "deck" just loosely means "pool of cards" and I'm the only one programming this.
-		auto* hand = GenerateDeck();
-		auto* player = new Player{ hand, _startingBank };
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_CREATE_PLAYER);
+
+		// Plain new only guarantees 16 byte alignment before C++17, so the player is placed in memory aligned to a cache line instead.
+		// Failing to allocate is reported the same way plain new reports it.
+		auto* memory = _aligned_malloc(sizeof(Player), alignof(Player));
+		if (memory == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		RECORD_ALLOCATION(sizeof(Player));
+		auto* player = new(memory) Player{ _startingBank, {} };
+
+		END_ALLOCATION_SCOPE();
 		return player;
 	}
 
 	void DestroyPlayer(Player*& _player)
 	{
-		// The player's deck must be de-allocated BEFORE the player themselves!
-		DestroyDeck(_player->m_hand);
-
-		delete _player;
+		// The player's hand is part of the player, so there's nothing else to de-allocate.
+		// Players are trivially destructible, so the aligned memory can be freed straight away.
+		// Aligned memory doesn't go through the global operators, so the tracker has to be told about it directly.
+		RECORD_FREE(sizeof(Player));
+		_aligned_free(_player);
 		_player = nullptr;
 	}
 
@@ -29,12 +43,12 @@ namespace blackjack
 	int GetTotalHandValue(Player* _player, const int _aceValue)
 	{
 		// This is just a proxy function for the one defined in Hand
-		return GetTotalHandValue(_player->m_hand, _aceValue);
+		return GetTotalHandValue(&_player->m_hand, _aceValue);
 	}
 
 	eHandValidityComparison CompareHands(Player* _a, Player* _b, const int _aceValue)
 	{
 		// This is just a proxy function for the one defined in Hand
-		return CompareHands(_a->m_hand, _b->m_hand, _aceValue);
+		return CompareHands(&_a->m_hand, &_b->m_hand, _aceValue);
 	}
 }
\ No newline at end of file
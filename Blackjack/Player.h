@@ -25,21 +25,36 @@ namespace blackjack
 	constexpr char c_playerNames[][7] = { "Dealer", "Player", "" };
 
 	/// <summary>
-	/// Data necessary for players.
+	/// The size of a cache line on every x86 processor the game is built for.
 	/// </summary>
-	struct Player
+	constexpr auto c_cacheLineSize = 64;
+
+	/// <summary>
+	/// The most cards a hand can hold while every one of them, along with the player's bank, is still in the player's first cache line.
+	/// </summary>
+	constexpr auto c_firstLineCards = 18;
+
+	/// <summary>
+	/// Data necessary for players.<br>
+	/// A full hand doesn't fit in one cache line, so each player is exactly two. The bank and the start of the hand share the first line,
+	/// so reading any hand of up to "c_firstLineCards" cards (which is every hand short of a pile of Aces) only ever touches that one line.
+	/// </summary>
+	struct alignas(c_cacheLineSize) Player
 	{
 		/// <summary>
-		/// The cards currently in the player's card.
+		/// The amount of money the player currently has available for bets.
 		/// </summary>
-		Deck* m_hand;
+		int m_bank;
 
 		/// <summary>
-		/// The amount of money the player currently has available for bets.
+		/// The cards currently in the player's hand, stored directly in the player.
 		/// </summary>
-		int m_bank;
+		Hand m_hand;
 	};
 
+	static_assert(sizeof(Player) == 2 * c_cacheLineSize, "A player should fit in exactly two cache lines.");
+	static_assert(sizeof(int) * 2 + sizeof(Card) * c_firstLineCards <= c_cacheLineSize, "The bank and the first cards of a hand should share one cache line.");
+
 	/// <summary>
 	/// Allocate memory to and create a new player in the heap.
 	/// </summary>
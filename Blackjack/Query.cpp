@@ -0,0 +1,356 @@
+#include "Query.h"
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "Game.h"
+#include "MappedFile.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// Get the size in bytes of one column of a block, including the padding that keeps the next column 8-byte aligned.
+	/// </summary>
+	static long long GetColumnSize(const int _rows, const int _width)
+	{
+		return ((long long)_rows * _width + 7) / 8 * 8;
+	}
+
+	/// <summary>
+	/// Get the size in bytes of a whole block, including its header.
+	/// </summary>
+	static long long GetBlockSize(const int _rows)
+	{
+		auto size = (long long)sizeof(ExportBlockHeader);
+		for (auto column = 0; column < TOTAL_EXPORT_COLUMNS; column++)
+		{
+			size += GetColumnSize(_rows, c_exportColumnWidths[column]);
+		}
+
+		return size;
+	}
+
+	/// <summary>
+	/// Check that a mapped file starts with a columnar header that this version of the program can read.
+	/// </summary>
+	static bool IsValidExportFile(const MappedFile* _file)
+	{
+		if (_file->m_size < (long long)sizeof(ExportFileHeader))
+		{
+			return false;
+		}
+
+		// Every column is read straight out of the file at the width it was written with, so the widths have to match exactly.
+		const auto* header = (const ExportFileHeader*)_file->m_view;
+		return memcmp(header->m_magic, c_exportMagic, sizeof(c_exportMagic)) == 0 && header->m_version == 1 &&
+			header->m_columnCount == TOTAL_EXPORT_COLUMNS && memcmp(header->m_columnWidths, c_exportColumnWidths, sizeof(header->m_columnWidths)) == 0;
+	}
+
+	/// <summary>
+	/// Find where every block in a mapped file starts. Only the block headers are touched, so this is quick even for huge files.
+	/// </summary>
+	/// <returns>False if a block is damaged, or runs past the end of the file.</returns>
+	static bool FindBlocks(const MappedFile* _file, std::vector<long long>& o_blocks)
+	{
+		auto offset = (long long)sizeof(ExportFileHeader);
+		while (offset < _file->m_size)
+		{
+			if (_file->m_size - offset < (long long)sizeof(ExportBlockHeader))
+			{
+				return false;
+			}
+
+			const auto rows = ((const ExportBlockHeader*)(_file->m_view + offset))->m_rows;
+			if (rows < 1 || rows > c_exportBlockRows || _file->m_size - offset < GetBlockSize(rows))
+			{
+				return false;
+			}
+
+			o_blocks.push_back(offset);
+			offset += GetBlockSize(rows);
+		}
+
+		return true;
+	}
+
+	/// <summary>
+	/// Clear the match of every row whose value in a column is outside of a range.
+	/// </summary>
+	static void FilterColumn(const unsigned char* _column, const int _width, const int _rows, const long long _min, const long long _max, unsigned char* o_matches)
+	{
+		// Each width gets its own loop, so the compiler can vectorise them without a branch on every value.
+		switch (_width)
+		{
+			case 1:
+			{
+				const auto* values = (const signed char*)_column;
+				for (auto row = 0; row < _rows; row++)
+				{
+					o_matches[row] &= (unsigned char)((values[row] >= _min) & (values[row] <= _max));
+				}
+				break;
+			}
+
+			case 4:
+			{
+				const auto* values = (const int*)_column;
+				for (auto row = 0; row < _rows; row++)
+				{
+					o_matches[row] &= (unsigned char)((values[row] >= _min) & (values[row] <= _max));
+				}
+				break;
+			}
+
+			default:
+			{
+				const auto* values = (const long long*)_column;
+				for (auto row = 0; row < _rows; row++)
+				{
+					o_matches[row] &= (unsigned char)((values[row] >= _min) & (values[row] <= _max));
+				}
+				break;
+			}
+		}
+	}
+
+	/// <summary>
+	/// A worker thread's main function. Claims blocks one at a time until there are none left, adding their matches to its own result.
+	/// </summary>
+	static void RunQueryWorker(const MappedFile* _file, const std::vector<long long>* _blocks, const QueryFilter* _filter,
+		std::atomic<long long>* _nextBlock, QueryResult* o_result)
+	{
+		// Rows are filtered one column at a time, into one flag per row. A block never has more rows than this.
+		auto* matches = new unsigned char[c_exportBlockRows];
+
+		for (auto block = _nextBlock->fetch_add(1); block < (long long)_blocks->size(); block = _nextBlock->fetch_add(1))
+		{
+			const auto* header = (const ExportBlockHeader*)(_file->m_view + (*_blocks)[block]);
+
+			// A block can be skipped without reading any of it if any column's values are all outside of the filter.
+			// Columns whose values are all inside of it don't need to be checked row by row either.
+			auto skip = false;
+			bool filtered[TOTAL_EXPORT_COLUMNS];
+			for (auto column = 0; column < TOTAL_EXPORT_COLUMNS; column++)
+			{
+				skip |= header->m_max[column] < _filter->m_min[column] || header->m_min[column] > _filter->m_max[column];
+				filtered[column] = header->m_min[column] < _filter->m_min[column] || header->m_max[column] > _filter->m_max[column];
+			}
+
+			if (skip)
+			{
+				o_result->m_skippedBlocks++;
+				continue;
+			}
+
+			const auto rows = header->m_rows;
+			o_result->m_rows += rows;
+			memset(matches, 1, rows);
+
+			const unsigned char* columns[TOTAL_EXPORT_COLUMNS];
+			auto* column = (const unsigned char*)(header + 1);
+			for (auto columnIndex = 0; columnIndex < TOTAL_EXPORT_COLUMNS; columnIndex++)
+			{
+				columns[columnIndex] = column;
+				if (filtered[columnIndex])
+				{
+					FilterColumn(column, c_exportColumnWidths[columnIndex], rows, _filter->m_min[columnIndex], _filter->m_max[columnIndex], matches);
+				}
+
+				column += GetColumnSize(rows, c_exportColumnWidths[columnIndex]);
+			}
+
+			// The file's widths were checked when it was opened, so outcomes are always single bytes and bets are always ints.
+			const auto* outcomes = (const signed char*)columns[EXPORT_COLUMN_OUTCOME];
+			const auto* bets = (const int*)columns[EXPORT_COLUMN_BET];
+			for (auto row = 0; row < rows; row++)
+			{
+				if (matches[row] == 0 || outcomes[row] < HAND_COMPARISON_LOSS || outcomes[row] > HAND_COMPARISON_NATURAL)
+				{
+					continue;
+				}
+
+				const auto outcome = (eHandValidityComparison)outcomes[row];
+				const auto result = (double)(GetPayout(outcome, bets[row]) - bets[row]) / bets[row];
+
+				o_result->m_matches++;
+				o_result->m_results[outcome]++;
+				o_result->m_totalResult += result;
+				o_result->m_totalResultSquared += result * result;
+			}
+		}
+
+		delete[] matches;
+	}
+
+	void ResetQueryFilter(QueryFilter* o_filter)
+	{
+		for (auto column = 0; column < TOTAL_EXPORT_COLUMNS; column++)
+		{
+			o_filter->m_min[column] = LLONG_MIN;
+			o_filter->m_max[column] = LLONG_MAX;
+		}
+	}
+
+	bool AddQueryCondition(const char _condition[], QueryFilter* o_filter)
+	{
+		const auto* equals = strchr(_condition, '=');
+		if (equals == nullptr)
+		{
+			return false;
+		}
+
+		auto column = 0;
+		const auto nameLength = (size_t)(equals - _condition);
+		while (column < TOTAL_EXPORT_COLUMNS &&
+			(strlen(c_exportColumnNames[column]) != nameLength || strncmp(c_exportColumnNames[column], _condition, nameLength) != 0))
+		{
+			column++;
+		}
+
+		if (column == TOTAL_EXPORT_COLUMNS)
+		{
+			return false;
+		}
+
+		// A single value is just a range that starts and ends on the same value.
+		char* end = nullptr;
+		const auto min = strtoll(equals + 1, &end, 10);
+		if (end == equals + 1)
+		{
+			return false;
+		}
+
+		auto max = min;
+		if (*end == ':')
+		{
+			const auto* maxStart = end + 1;
+			max = strtoll(maxStart, &end, 10);
+			if (end == maxStart)
+			{
+				return false;
+			}
+		}
+
+		if (*end != '\0' || min > max)
+		{
+			return false;
+		}
+
+		o_filter->m_min[column] = min;
+		o_filter->m_max[column] = max;
+		return true;
+	}
+
+	bool RunQuery(const char _path[], const QueryFilter* _filter, const int _threads, QueryResult* o_result)
+	{
+		*o_result = QueryResult{};
+
+		auto* file = OpenMappedFile(_path, 0, false);
+		if (file == nullptr)
+		{
+			return false;
+		}
+
+		std::vector<long long> blocks;
+		if (!IsValidExportFile(file) || !FindBlocks(file, blocks))
+		{
+			CloseMappedFile(file);
+			return false;
+		}
+
+		auto threadCount = _threads > 0 ? _threads : (int)std::thread::hardware_concurrency();
+		threadCount = threadCount < 1 ? 1 : threadCount;
+
+		// Just like the simulation, every thread fills its own result, and they're only combined once every thread is done.
+		std::vector<QueryResult> results(threadCount, QueryResult{});
+		std::vector<std::thread> threads;
+		std::atomic<long long> nextBlock(0);
+
+		for (auto threadIndex = 0; threadIndex < threadCount; threadIndex++)
+		{
+			threads.emplace_back(RunQueryWorker, file, &blocks, _filter, &nextBlock, &results[threadIndex]);
+		}
+
+		for (auto threadIndex = 0; threadIndex < threadCount; threadIndex++)
+		{
+			threads[threadIndex].join();
+
+			const auto& result = results[threadIndex];
+			o_result->m_skippedBlocks += result.m_skippedBlocks;
+			o_result->m_rows += result.m_rows;
+			o_result->m_matches += result.m_matches;
+			o_result->m_totalResult += result.m_totalResult;
+			o_result->m_totalResultSquared += result.m_totalResultSquared;
+
+			for (auto outcome = 0; outcome <= HAND_COMPARISON_NATURAL; outcome++)
+			{
+				o_result->m_results[outcome] += result.m_results[outcome];
+			}
+		}
+
+		o_result->m_blocks = (long long)blocks.size();
+
+		CloseMappedFile(file);
+		return true;
+	}
+
+	int RunQueryCommand(const char _path[], char* _conditions[], const int _conditionCount)
+	{
+		QueryFilter filter{};
+		ResetQueryFilter(&filter);
+
+		for (auto condition = 0; condition < _conditionCount; condition++)
+		{
+			if (!AddQueryCondition(_conditions[condition], &filter))
+			{
+				std::cout << "Could not read the condition \"" << _conditions[condition] << "\". Conditions look like column=value or column=min:max, using the columns:\n";
+				for (auto column = 0; column < TOTAL_EXPORT_COLUMNS; column++)
+				{
+					std::cout << c_exportColumnNames[column] << (column + 1 < TOTAL_EXPORT_COLUMNS ? ", " : "\n");
+				}
+
+				return 1;
+			}
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+
+		QueryResult result{};
+		if (!RunQuery(_path, &filter, 0, &result))
+		{
+			std::cout << "Could not read " << _path << " as a columnar export!\n";
+			return 1;
+		}
+
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << std::fixed << std::setprecision(2);
+		std::cout << "Blocks: " << result.m_blocks << " (" << result.m_skippedBlocks << " skipped) Rows Scanned: " << result.m_rows <<
+			" Matches: " << result.m_matches << "\n";
+
+		if (result.m_matches > 0)
+		{
+			const auto matches = (double)result.m_matches;
+			const auto mean = result.m_totalResult / matches;
+			const auto variance = result.m_totalResultSquared / matches - mean * mean;
+
+			std::cout << "Loss: " << 100.0 * result.m_results[HAND_COMPARISON_LOSS] / matches << "%" <<
+				" Tie: " << 100.0 * result.m_results[HAND_COMPARISON_TIE] / matches << "%" <<
+				" Win: " << 100.0 * result.m_results[HAND_COMPARISON_WIN] / matches << "%" <<
+				" Natural: " << 100.0 * result.m_results[HAND_COMPARISON_NATURAL] / matches << "%\n";
+			std::cout << "Expected Value: " << 100.0 * mean << "% of each bet, Standard Deviation: " << std::sqrt(variance) << " bets\n";
+		}
+
+		std::cout << "Queried in " << elapsed.count() << " seconds (" << std::setprecision(0) <<
+			(double)result.m_rows / (elapsed.count() > 0.0 ? elapsed.count() : 1.0) << " rows per second).\n";
+		return 0;
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#ifndef QUERY_H_
+#define QUERY_H_
+
+#include "Export.h"
+#include "Hand.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The command line argument that queries an exported file instead of opening the menu.<br>
+	/// It's followed by the file's path, then any amount of conditions, i.e. "upcard=11 player_total=16" or "bet=10:50".
+	/// </summary>
+	constexpr char c_queryArgument[] = "--query";
+
+	/// <summary>
+	/// Which rounds a query matches. A round matches if every one of its columns is from the column's minimum to its maximum (inclusive).
+	/// </summary>
+	struct QueryFilter
+	{
+		long long m_min[TOTAL_EXPORT_COLUMNS];
+		long long m_max[TOTAL_EXPORT_COLUMNS];
+	};
+
+	/// <summary>
+	/// The combined results of every round a query matched, along with how much of the file it had to read to find them.
+	/// </summary>
+	struct QueryResult
+	{
+		long long m_blocks;
+
+		/// <summary>
+		/// The amount of blocks that were never read, since their minimums and maximums showed that none of their rounds could match.
+		/// </summary>
+		long long m_skippedBlocks;
+
+		long long m_rows;
+		long long m_matches;
+
+		/// <summary>
+		/// How many of the matching rounds ended in each result, indexed by eHandValidityComparison.
+		/// </summary>
+		long long m_results[HAND_COMPARISON_NATURAL + 1];
+
+		/// <summary>
+		/// The sum of every matching round's net result and its square, measured in bets. Used for the expected value and variance.
+		/// </summary>
+		double m_totalResult;
+		double m_totalResultSquared;
+	};
+
+	/// <summary>
+	/// Set a filter up to match every round.
+	/// </summary>
+	/// <param name="o_filter">The filter to be reset.</param>
+	void ResetQueryFilter(QueryFilter* o_filter);
+
+	/// <summary>
+	/// Narrow a filter down with a condition of the form "column=value" or "column=min:max", using the column names of the CSV header.
+	/// </summary>
+	/// <param name="_condition">The condition to add.</param>
+	/// <param name="o_filter">The filter to be narrowed down. Conditions on the same column replace each other.</param>
+	/// <returns>False if the condition couldn't be read, or names a column that doesn't exist. The filter is left as it was if so.</returns>
+	bool AddQueryCondition(const char _condition[], QueryFilter* o_filter);
+
+	/// <summary>
+	/// Scan every round in a memory-mapped columnar file in parallel, adding the ones that match a filter to a result.<br>
+	/// Threads claim one block at a time, and skip any block whose minimums and maximums don't overlap the filter.
+	/// </summary>
+	/// <param name="_path">The columnar file to query, as written by an ExportWriter.</param>
+	/// <param name="_filter">Which rounds to match.</param>
+	/// <param name="_threads">The amount of threads to scan with. 0 uses one per hardware thread.</param>
+	/// <param name="o_result">The result to be output into. Anything already in it is overwritten.</param>
+	/// <returns>False if the file couldn't be opened, or isn't a columnar file written by this version of the program.</returns>
+	bool RunQuery(const char _path[], const QueryFilter* _filter, int _threads, QueryResult* o_result);
+
+	/// <summary>
+	/// Read a query from the command line, run it, and display the results.
+	/// </summary>
+	/// <param name="_path">The columnar file to query.</param>
+	/// <param name="_conditions">Every condition the rounds have to match.</param>
+	/// <param name="_conditionCount">The amount of conditions.</param>
+	/// <returns>The process exit code. 0 if the query ran, 1 if it couldn't be read or the file couldn't be opened.</returns>
+	int RunQueryCommand(const char _path[], char* _conditions[], int _conditionCount);
+}
+
+#endif
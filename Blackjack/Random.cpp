@@ -0,0 +1,37 @@
+#include "Random.h"
+
+namespace blackjack
+{
+	void SeedRandom(Random* _random, const unsigned long long _seed)
+	{
+		_random->m_state = _seed;
+	}
+
+	unsigned long long NextRandom(Random* _random)
+	{
+		// SplitMix64. The state is just a counter; all of the actual "randomness" comes from the mixing steps below.
+		_random->m_state += 0x9E3779B97F4A7C15ull;
+
+		auto value = _random->m_state;
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+		return value ^ (value >> 31);
+	}
+
+	int RandomRange(Random* _random, const int _max)
+	{
+		// Multiplying the top 32 bits by the range and keeping the high half maps them evenly onto [0, _max).
+		// This avoids both the division and the low-bit bias of "rand() % _max".
+		const auto high = NextRandom(_random) >> 32;
+		return (int)((high * (unsigned long long)_max) >> 32);
+	}
+
+	unsigned long long DeriveSeed(const unsigned long long _seed, const unsigned long long _stream)
+	{
+		// Seeding with "_seed + _stream" directly would make each stream the previous one shifted along by a single number.
+		// Running it through the mixer once first scatters the streams across the whole state space.
+		Random random;
+		SeedRandom(&random, _seed ^ _stream * 0xD1B54A32D192ED03ull);
+		return NextRandom(&random);
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+namespace blackjack
+{
+	/// <summary>
+	/// A small, seedable random number generator (SplitMix64).<br>
+	/// Unlike rand(), every instance keeps its own state, so one can be handed to another thread without any locking.
+	/// </summary>
+	struct Random
+	{
+		unsigned long long m_state;
+	};
+
+	/// <summary>
+	/// Reset a random number generator to a known starting point. The same seed will always produce the same numbers.
+	/// </summary>
+	/// <param name="_random">The generator to be seeded.</param>
+	/// <param name="_seed">Any value. Zero is fine, too.</param>
+	void SeedRandom(Random* _random, unsigned long long _seed);
+
+	/// <summary>
+	/// Advance a random number generator and get its next 64-bit value.
+	/// </summary>
+	/// <param name="_random">The generator to advance.</param>
+	/// <returns>A random 64-bit value.</returns>
+	unsigned long long NextRandom(Random* _random);
+
+	/// <summary>
+	/// Get a random integer from 0 (inclusive) to a maximum value (exclusive).
+	/// </summary>
+	/// <param name="_random">The generator to advance.</param>
+	/// <param name="_max">The exclusive upper bound. MUST be greater than 0.</param>
+	/// <returns>A random integer in the range [0, _max).</returns>
+	int RandomRange(Random* _random, int _max);
+
+	/// <summary>
+	/// Get a seed for one of many independent streams, i.e. one per simulated session, from a single master seed.
+	/// </summary>
+	/// <param name="_seed">The master seed.</param>
+	/// <param name="_stream">The index of the stream.</param>
+	/// <returns>A seed that is unrelated to the seeds of neighbouring streams.</returns>
+	unsigned long long DeriveSeed(unsigned long long _seed, unsigned long long _stream);
+}
+
+#endif
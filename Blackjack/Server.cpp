@@ -0,0 +1,641 @@
+#include "Server.h"
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "Game.h"
+#include "IO.h"
+#include "Random.h"
+#include "SessionPool.h"
+#include "Trace.h"
+
+// Winsock lives in its own library, which console applications don't link by default.
+#pragma comment(lib, "Ws2_32.lib")
+
+namespace blackjack
+{
+	/// <summary>
+	/// The bytes of pending output every connection reserves when the server starts. One reply is only a few hundred bytes, so this is
+	/// only ever outgrown by a player who stops reading while their game keeps displaying things.
+	/// </summary>
+	constexpr auto c_pendingOutputCapacity = 4096;
+
+	/// <summary>
+	/// A stream buffer that appends everything written to it straight onto the end of a string, without buffering anything itself.
+	/// </summary>
+	class PendingOutputBuffer : public std::streambuf
+	{
+	public:
+		std::string* m_pending = nullptr;
+
+	protected:
+		int_type overflow(const int_type _character) override
+		{
+			if (!traits_type::eq_int_type(_character, traits_type::eof()))
+			{
+				m_pending->push_back(traits_type::to_char_type(_character));
+			}
+			return traits_type::not_eof(_character);
+		}
+
+		std::streamsize xsputn(const char* _characters, const std::streamsize _count) override
+		{
+			m_pending->append(_characters, (size_t)_count);
+			return _count;
+		}
+	};
+
+	/// <summary>
+	/// One player's connection to the server. Every connection owns its own game, which only ever advances when a line arrives.
+	/// </summary>
+	struct Connection
+	{
+		SOCKET m_socket;
+
+		Game* m_game;
+
+		/// <summary>
+		/// Everything the game displays is written here, which goes straight onto the end of "m_pending" to be sent.
+		/// </summary>
+		PendingOutputBuffer m_outputBuffer;
+		std::ostream m_output{ &m_outputBuffer };
+
+		/// <summary>
+		/// The line currently being received. Lines that are too long are still read to the end, but are invalid.
+		/// </summary>
+		char m_line[c_maxInputLength];
+		int m_lineSize;
+		bool m_lineOverflow;
+
+		/// <summary>
+		/// Output that hasn't been sent yet, from "m_pendingOffset" onwards. The socket's buffer can fill up if the player isn't reading.<br>
+		/// Clearing it keeps its capacity, so once it's reserved, writing to it never allocates unless a single backlog outgrows it.
+		/// </summary>
+		std::string m_pending;
+		size_t m_pendingOffset;
+
+		/// <summary>
+		/// Set once the game is finished. The connection is closed as soon as everything pending has been sent.
+		/// </summary>
+		bool m_closing;
+	};
+
+	/// <summary>
+	/// Every connection, and everything WSAPoll needs to wait on them all at once.<br>
+	/// The listening socket is always the first poll entry, and every connection's entry is one after its own index.
+	/// </summary>
+	struct Server
+	{
+		SOCKET m_listener;
+
+		WSAPOLLFD m_pollEntries[c_maxConnections + 1];
+
+		/// <summary>
+		/// Every connection, open or not. The first "m_connectionCount" are open, and the rest are ready to be reused.<br>
+		/// Closing a connection swaps it with the last open one, so this never has to be searched for a free connection.
+		/// </summary>
+		Connection* m_connections[c_maxConnections];
+		int m_connectionCount;
+		int m_capacity;
+
+		/// <summary>
+		/// Where every connection's game comes from. There's a game for every connection, so this never runs out.
+		/// </summary>
+		SessionPool* m_sessions;
+
+		/// <summary>
+		/// Seeds every game taken from the pool, so that no two sessions play the same shoe.
+		/// </summary>
+		Random m_random;
+	};
+
+	/// <summary>
+	/// One of the load generator's sessions, which is waiting for either a prompt or an answer to its last input.
+	/// </summary>
+	struct LoadSession
+	{
+		SOCKET m_socket;
+
+		/// <summary>
+		/// Everything received since the last input was sent.
+		/// </summary>
+		std::string m_reply;
+
+		/// <summary>
+		/// When the last input was sent. Only meaningful if "m_waiting" is set.
+		/// </summary>
+		std::chrono::steady_clock::time_point m_sent;
+		bool m_waiting;
+	};
+
+	/// <summary>
+	/// Stop a socket from ever blocking, and send small writes straight away instead of waiting to batch them up.
+	/// </summary>
+	static void ConfigureSocket(const SOCKET _socket)
+	{
+		u_long nonBlocking = 1;
+		ioctlsocket(_socket, FIONBIO, &nonBlocking);
+
+		// Every reply is only a few hundred bytes. Nagle's algorithm would hold each one back waiting for an acknowledgement.
+		const int noDelay = 1;
+		setsockopt(_socket, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, sizeof(noDelay));
+	}
+
+	/// <summary>
+	/// Get the localhost address for a port.
+	/// </summary>
+	static sockaddr_in GetLocalAddress(const unsigned short _port)
+	{
+		sockaddr_in address{};
+		address.sin_family = AF_INET;
+		address.sin_port = htons(_port);
+		inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+		return address;
+	}
+
+	/// <summary>
+	/// Send as much pending output as the socket will take without blocking.
+	/// </summary>
+	/// <returns>False if the connection has been lost.</returns>
+	static bool SendPending(Connection* _connection)
+	{
+		while (_connection->m_pendingOffset < _connection->m_pending.size())
+		{
+			const auto sent = send(_connection->m_socket, _connection->m_pending.data() + _connection->m_pendingOffset,
+				(int)(_connection->m_pending.size() - _connection->m_pendingOffset), 0);
+			if (sent == SOCKET_ERROR)
+			{
+				// The rest is sent when WSAPoll says the socket is writable again.
+				return WSAGetLastError() == WSAEWOULDBLOCK;
+			}
+
+			_connection->m_pendingOffset += sent;
+		}
+
+		_connection->m_pending.clear();
+		_connection->m_pendingOffset = 0;
+		return true;
+	}
+
+	/// <summary>
+	/// Give a connection's game a complete line of input, validating it the same way GetInput does.
+	/// </summary>
+	static void SubmitLine(Connection* _connection)
+	{
+		auto* game = _connection->m_game;
+		const auto maxInput = GetInputMax(game);
+
+		// Pause states take any line at all, just like PAUSE takes any key.
+		auto input = 0;
+		if (maxInput > 0 && (_connection->m_lineOverflow || !ParseLine(_connection->m_line, input) || input < 1 || input > maxInput))
+		{
+			*game->m_output << "Invalid Input.\n";
+		}
+		else
+		{
+			AdvanceGame(game, input);
+		}
+
+		if (game->m_state == GAME_STATE_FINISHED)
+		{
+			_connection->m_closing = true;
+		}
+		else
+		{
+			DisplayGamePrompt(game);
+		}
+	}
+
+	/// <summary>
+	/// Read everything that's arrived on a connection, submitting each complete line to its game.
+	/// </summary>
+	/// <returns>False if the connection has been closed or lost.</returns>
+	static bool ReceiveLines(Connection* _connection)
+	{
+		char buffer[c_receiveBufferSize];
+
+		const auto received = recv(_connection->m_socket, buffer, c_receiveBufferSize, 0);
+		if (received == 0)
+		{
+			return false;
+		}
+		if (received == SOCKET_ERROR)
+		{
+			return WSAGetLastError() == WSAEWOULDBLOCK;
+		}
+
+		for (auto i = 0; i < received && !_connection->m_closing; i++)
+		{
+			if (buffer[i] == '\n')
+			{
+				// Terminals send "\r\n", but only the "\n" should count.
+				if (_connection->m_lineSize > 0 && _connection->m_line[_connection->m_lineSize - 1] == '\r')
+				{
+					_connection->m_lineSize--;
+				}
+				_connection->m_line[_connection->m_lineSize] = 0;
+
+				SubmitLine(_connection);
+
+				_connection->m_lineSize = 0;
+				_connection->m_lineOverflow = false;
+			}
+			else if (_connection->m_lineSize < c_maxInputLength - 1)
+			{
+				_connection->m_line[_connection->m_lineSize++] = buffer[i];
+			}
+			else
+			{
+				_connection->m_lineOverflow = true;
+			}
+		}
+
+		return SendPending(_connection);
+	}
+
+	/// <summary>
+	/// Accept every connection that's waiting, and start each one's game.
+	/// </summary>
+	static void AcceptConnections(Server* _server)
+	{
+		while (true)
+		{
+			const auto socket = accept(_server->m_listener, nullptr, nullptr);
+			if (socket == INVALID_SOCKET)
+			{
+				break;
+			}
+
+			if (_server->m_connectionCount >= _server->m_capacity)
+			{
+				closesocket(socket);
+				continue;
+			}
+
+			ConfigureSocket(socket);
+
+			// Connections are reused rather than allocated. Their pending output was cleared when they were last sent, which keeps its capacity.
+			auto* connection = _server->m_connections[_server->m_connectionCount];
+			connection->m_socket = socket;
+			connection->m_lineSize = 0;
+			connection->m_lineOverflow = false;
+			connection->m_pending.clear();
+			connection->m_pendingOffset = 0;
+			connection->m_closing = false;
+
+			connection->m_game = AcquireSession(_server->m_sessions, NextRandom(&_server->m_random));
+			connection->m_game->m_output = &connection->m_output;
+			connection->m_game->m_console = false;
+
+			StartGame(connection->m_game);
+			DisplayGamePrompt(connection->m_game);
+
+			_server->m_pollEntries[_server->m_connectionCount + 1] = { socket, POLLRDNORM, 0 };
+			_server->m_connectionCount++;
+
+			SendPending(connection);
+		}
+	}
+
+	/// <summary>
+	/// Close a connection and give its game back to the pool. The last open connection is swapped into its place.
+	/// </summary>
+	static void CloseConnection(Server* _server, const int _index)
+	{
+		auto* connection = _server->m_connections[_index];
+
+		closesocket(connection->m_socket);
+		ReleaseSession(_server->m_sessions, connection->m_game);
+
+		const auto last = _server->m_connectionCount - 1;
+		_server->m_connections[_index] = _server->m_connections[last];
+		_server->m_connections[last] = connection;
+		_server->m_pollEntries[_index + 1] = _server->m_pollEntries[last + 1];
+		_server->m_connectionCount--;
+	}
+
+	/// <summary>
+	/// Close every connection, then free the memory allocated to the server and everything it's been using.
+	/// </summary>
+	static void DestroyServer(Server*& _server)
+	{
+		while (_server->m_connectionCount > 0)
+		{
+			CloseConnection(_server, _server->m_connectionCount - 1);
+		}
+
+		for (auto index = 0; index < _server->m_capacity; index++)
+		{
+			delete _server->m_connections[index];
+		}
+
+		DestroySessionPool(_server->m_sessions);
+		closesocket(_server->m_listener);
+
+		delete _server;
+		_server = nullptr;
+	}
+
+	int RunServer(const unsigned short _port, const int _capacity)
+	{
+		WSADATA winsockData;
+		if (WSAStartup(MAKEWORD(2, 2), &winsockData) != 0)
+		{
+			std::cout << "Could not start Winsock!\n";
+			return 1;
+		}
+
+		auto* server = new Server{};
+		server->m_listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+		// Every connection and game is made up front, so that a storm of new connections never has to wait on the heap.
+		server->m_capacity = _capacity;
+		for (auto index = 0; index < _capacity; index++)
+		{
+			auto* connection = new Connection();
+			connection->m_outputBuffer.m_pending = &connection->m_pending;
+			connection->m_pending.reserve(c_pendingOutputCapacity);
+			server->m_connections[index] = connection;
+		}
+		server->m_sessions = CreateSessionPool(_capacity, 1);
+		SeedRandom(&server->m_random, (unsigned long long)rand() << 32 | (unsigned long long)rand());
+
+		const auto address = GetLocalAddress(_port);
+		if (server->m_listener == INVALID_SOCKET || bind(server->m_listener, (const sockaddr*)&address, sizeof(address)) == SOCKET_ERROR ||
+			listen(server->m_listener, SOMAXCONN) == SOCKET_ERROR)
+		{
+			std::cout << "Could not listen on port " << _port << "!\n";
+
+			DestroyServer(server);
+			WSACleanup();
+			return 1;
+		}
+
+		ConfigureSocket(server->m_listener);
+		server->m_pollEntries[0] = { server->m_listener, POLLRDNORM, 0 };
+
+		std::cout << "Blackjack server listening on 127.0.0.1:" << _port << " for up to " << _capacity << " players\n" << std::flush;
+
+		while (true)
+		{
+			if (WSAPoll(server->m_pollEntries, server->m_connectionCount + 1, -1) == SOCKET_ERROR)
+			{
+				break;
+			}
+
+			// Connections are handled from the back, so that closing one only ever moves a connection that's already been handled.
+			for (auto index = server->m_connectionCount - 1; index >= 0; index--)
+			{
+				auto* connection = server->m_connections[index];
+				auto& entry = server->m_pollEntries[index + 1];
+
+				auto open = (entry.revents & (POLLERR | POLLNVAL)) == 0;
+				if (open && (entry.revents & (POLLRDNORM | POLLHUP)) != 0)
+				{
+					open = ReceiveLines(connection);
+				}
+				if (open && (entry.revents & POLLWRNORM) != 0)
+				{
+					open = SendPending(connection);
+				}
+
+				const auto sending = !connection->m_pending.empty();
+				if (!open || (connection->m_closing && !sending))
+				{
+					CloseConnection(server, index);
+					continue;
+				}
+
+				// Only wait to write while there's something to send, otherwise WSAPoll would return straight away every time.
+				entry.events = (short)(sending ? POLLRDNORM | POLLWRNORM : POLLRDNORM);
+				entry.revents = 0;
+			}
+
+			if ((server->m_pollEntries[0].revents & POLLRDNORM) != 0)
+			{
+				AcceptConnections(server);
+			}
+			server->m_pollEntries[0].revents = 0;
+		}
+
+		std::cout << "The server stopped unexpectedly! (" << WSAGetLastError() << ")\n";
+
+		DestroyServer(server);
+		WSACleanup();
+		return 1;
+	}
+
+	/// <summary>
+	/// Open a new session on the server for the load generator.
+	/// </summary>
+	/// <returns>False if the server couldn't be connected to.</returns>
+	static bool ConnectLoadSession(LoadSession* _session, const unsigned short _port)
+	{
+		_session->m_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		_session->m_reply.clear();
+		_session->m_waiting = false;
+
+		// Connecting is allowed to block, since it's the replies that are being measured.
+		const auto address = GetLocalAddress(_port);
+		if (_session->m_socket == INVALID_SOCKET || connect(_session->m_socket, (const sockaddr*)&address, sizeof(address)) == SOCKET_ERROR)
+		{
+			closesocket(_session->m_socket);
+			return false;
+		}
+
+		ConfigureSocket(_session->m_socket);
+		return true;
+	}
+
+	/// <summary>
+	/// Check whether a reply has finished, by whether its last line is a whole prompt.
+	/// </summary>
+	static bool IsReplyComplete(const std::string& _reply)
+	{
+		const auto lineStart = _reply.rfind('\n') + 1;
+		const auto lastLine = _reply.substr(lineStart);
+
+		if (lastLine.compare(0, 14, "Please select ") == 0)
+		{
+			const auto size = lastLine.size();
+			return lastLine.compare(size - 2, 2, ": ") == 0 || lastLine.compare(size - 3, 3, ": \x9C") == 0;
+		}
+
+		return lastLine == "Press enter to continue . . . ";
+	}
+
+	/// <summary>
+	/// Pick a random valid input for whatever a reply's prompt is asking for.
+	/// </summary>
+	/// <returns>The line to send back, including its newline.</returns>
+	static std::string ChooseLoadInput(const std::string& _reply, Random* _random)
+	{
+		const auto prompt = _reply.rfind("Please select ");
+		if (prompt == std::string::npos)
+		{
+			// Pauses take any line.
+			return "\n";
+		}
+
+		// Skip past " to " and whichever prefix the maximum value has.
+		auto maxStart = _reply.find(" to ", prompt) + 4;
+		while (_reply[maxStart] < '0' || _reply[maxStart] > '9')
+		{
+			maxStart++;
+		}
+		auto maxInput = atoi(_reply.c_str() + maxStart);
+
+		// Small bets keep sessions going for longer, which is closer to how people actually play.
+		if (_reply.find("a value", prompt) != std::string::npos)
+		{
+			maxInput = std::min(maxInput, 10);
+		}
+
+		return std::to_string(RandomRange(_random, maxInput) + 1) + "\n";
+	}
+
+	int RunLoadGenerator(const int _sessions, const long long _actions, const unsigned short _port)
+	{
+		WSADATA winsockData;
+		if (WSAStartup(MAKEWORD(2, 2), &winsockData) != 0)
+		{
+			std::cout << "Could not start Winsock!\n";
+			return 1;
+		}
+
+		Random random;
+		SeedRandom(&random, (unsigned long long)rand() << 32 | (unsigned long long)rand());
+
+		std::vector<LoadSession> sessions((size_t)_sessions);
+		std::vector<WSAPOLLFD> pollEntries((size_t)_sessions);
+		for (auto index = 0; index < _sessions; index++)
+		{
+			if (!ConnectLoadSession(&sessions[index], _port))
+			{
+				std::cout << "Could not connect to the server on port " << _port << "!\n";
+
+				for (auto opened = 0; opened < index; opened++)
+				{
+					closesocket(sessions[opened].m_socket);
+				}
+				WSACleanup();
+				return 1;
+			}
+
+			pollEntries[index] = { sessions[index].m_socket, POLLRDNORM, 0 };
+		}
+
+		std::vector<long long> latencies;
+		latencies.reserve((size_t)_actions);
+		auto sessionsStarted = (long long)_sessions;
+		auto sent = 0LL;
+
+		const auto start = std::chrono::steady_clock::now();
+		while ((long long)latencies.size() < _actions)
+		{
+			if (WSAPoll(pollEntries.data(), (ULONG)_sessions, -1) == SOCKET_ERROR)
+			{
+				break;
+			}
+
+			for (auto index = 0; index < _sessions; index++)
+			{
+				auto& entry = pollEntries[index];
+				if (entry.revents == 0)
+				{
+					continue;
+				}
+				entry.revents = 0;
+
+				auto& session = sessions[index];
+				char buffer[c_receiveBufferSize];
+				const auto received = recv(session.m_socket, buffer, c_receiveBufferSize, 0);
+				if (received == SOCKET_ERROR && WSAGetLastError() == WSAEWOULDBLOCK)
+				{
+					continue;
+				}
+
+				const auto now = std::chrono::steady_clock::now();
+				if (received <= 0)
+				{
+					// The server closes a session once its game is finished, which answers the last input.
+					if (session.m_waiting)
+					{
+						latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now - session.m_sent).count());
+					}
+
+					closesocket(session.m_socket);
+					if (!ConnectLoadSession(&session, _port))
+					{
+						std::cout << "Lost the connection to the server!\n";
+
+						for (auto other = 0; other < _sessions; other++)
+						{
+							if (other != index)
+							{
+								closesocket(sessions[other].m_socket);
+							}
+						}
+						WSACleanup();
+						return 1;
+					}
+
+					entry.fd = session.m_socket;
+					sessionsStarted++;
+					continue;
+				}
+
+				session.m_reply.append(buffer, (size_t)received);
+				if (!IsReplyComplete(session.m_reply))
+				{
+					continue;
+				}
+
+				if (session.m_waiting)
+				{
+					latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now - session.m_sent).count());
+				}
+
+				// Only send as many inputs as there are actions left, so that every one of them is answered.
+				session.m_waiting = false;
+				if (sent < _actions)
+				{
+					const auto line = ChooseLoadInput(session.m_reply, &random);
+					session.m_sent = std::chrono::steady_clock::now();
+					session.m_waiting = true;
+					send(session.m_socket, line.data(), (int)line.size(), 0);
+					sent++;
+				}
+				session.m_reply.clear();
+			}
+		}
+		const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		for (auto& session : sessions)
+		{
+			closesocket(session.m_socket);
+		}
+		WSACleanup();
+
+		if (latencies.empty())
+		{
+			std::cout << "No actions were answered!\n";
+			return 1;
+		}
+
+		std::sort(latencies.begin(), latencies.end());
+		std::cout << "Actions: " << latencies.size() << " Sessions: " << sessionsStarted << " Time: " << seconds << "s" <<
+			" Actions per Second: " << (long long)((double)latencies.size() / seconds) << "\n";
+		std::cout << "Latency (microseconds) 50%: " << GetLatencyQuantile(latencies, 0.5) << " 99%: " << GetLatencyQuantile(latencies, 0.99) <<
+			" Max: " << GetLatencyQuantile(latencies, 1.0) << "\n";
+
+		return (long long)latencies.size() < _actions ? 1 : 0;
+	}
+}
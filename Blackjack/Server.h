@@ -0,0 +1,56 @@
+#pragma once
+
+#ifndef SERVER_H_
+#define SERVER_H_
+
+namespace blackjack
+{
+	/// <summary>
+	/// The command line argument that starts the program as a game server, rather than opening the menu.<br>
+	/// The server is started as "Blackjack.exe --serve (port) (players)", where the port and the most players at once are optional.
+	/// </summary>
+	constexpr char c_serverArgument[] = "--serve";
+
+	/// <summary>
+	/// The command line argument that starts the program as a load generator for a server that's already running.<br>
+	/// The load generator is started as "Blackjack.exe --load (sessions) (actions) (port)", where the port is optional.
+	/// </summary>
+	constexpr char c_loadArgument[] = "--load";
+
+	/// <summary>
+	/// The port the server listens on, if one isn't given. The server only ever listens on localhost.
+	/// </summary>
+	constexpr unsigned short c_defaultServerPort = 27015;
+
+	/// <summary>
+	/// The most players that can ever be connected to the server at once, however many it's started with.
+	/// </summary>
+	constexpr auto c_maxConnections = 16384;
+
+	/// <summary>
+	/// The most bytes read from a socket at once. Input lines are tiny, so this is plenty for many of them.
+	/// </summary>
+	constexpr auto c_receiveBufferSize = 4096;
+
+	/// <summary>
+	/// Host games for many players at once, from a single thread.<br>
+	/// Each connection has a game, and speaks the same lines the console does: the game's text is sent, and each input is a line back.<br>
+	/// Runs until the process is closed.
+	/// </summary>
+	/// <param name="_port">The localhost port to listen on.</param>
+	/// <param name="_capacity">The most players connected at once. Anyone connecting after this is disconnected straight away. MUST be from 1 to "c_maxConnections".</param>
+	/// <returns>The process exit code. Only returns if the server couldn't be started.</returns>
+	int RunServer(unsigned short _port, int _capacity);
+
+	/// <summary>
+	/// Connect many sessions to a running server and play them with random inputs, measuring how long each action takes to be answered.<br>
+	/// Whenever a session's game finishes, a new one is connected in its place.
+	/// </summary>
+	/// <param name="_sessions">The amount of sessions connected at once.</param>
+	/// <param name="_actions">The total amount of inputs to send, across every session, before reporting.</param>
+	/// <param name="_port">The localhost port the server is listening on.</param>
+	/// <returns>The process exit code. 0 if every action was answered.</returns>
+	int RunLoadGenerator(int _sessions, long long _actions, unsigned short _port);
+}
+
+#endif
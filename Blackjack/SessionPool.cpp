@@ -0,0 +1,51 @@
+#include "SessionPool.h"
+
+namespace blackjack
+{
+	SessionPool* CreateSessionPool(const int _capacity, const int _decks)
+	{
+		auto* pool = new SessionPool{ new Game*[_capacity], new Game*[_capacity], _capacity, _capacity };
+
+		// Pooled games are only ever driven by something else, so none of them need a background shuffler.
+		for (auto index = 0; index < _capacity; index++)
+		{
+			pool->m_games[index] = InitGame(false, _decks, false);
+			pool->m_freeGames[index] = pool->m_games[index];
+		}
+
+		return pool;
+	}
+
+	void DestroySessionPool(SessionPool*& _pool)
+	{
+		for (auto index = 0; index < _pool->m_capacity; index++)
+		{
+			EndGame(_pool->m_games[index]);
+		}
+
+		delete[] _pool->m_games;
+		delete[] _pool->m_freeGames;
+
+		delete _pool;
+		_pool = nullptr;
+	}
+
+	Game* AcquireSession(SessionPool* _pool, const unsigned long long _seed)
+	{
+		if (_pool->m_freeCount < 1)
+		{
+			return nullptr;
+		}
+
+		auto* game = _pool->m_freeGames[--_pool->m_freeCount];
+		ResetGame(game, _seed);
+
+		return game;
+	}
+
+	void ReleaseSession(SessionPool* _pool, Game*& _game)
+	{
+		_pool->m_freeGames[_pool->m_freeCount++] = _game;
+		_game = nullptr;
+	}
+}
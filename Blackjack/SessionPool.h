@@ -0,0 +1,67 @@
+#pragma once
+
+#ifndef SESSION_POOL_H_
+#define SESSION_POOL_H_
+
+#include "Game.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// How many games are made ready up front for the server, if it isn't told otherwise.
+	/// </summary>
+	constexpr auto c_defaultSessionPoolSize = 4096;
+
+	/// <summary>
+	/// A fixed amount of fully initialised games, which sessions take and give back instead of creating and ending their own.<br>
+	/// Everything is allocated when the pool is created, so starting a session never allocates anything.
+	/// </summary>
+	struct SessionPool
+	{
+		/// <summary>
+		/// Every game in the pool, whether it's in use or not.
+		/// </summary>
+		Game** m_games;
+
+		/// <summary>
+		/// Every game that isn't in use. Only the first "m_freeCount" are valid.<br>
+		/// This is used as a stack, so the most recently released game is taken first, since it's the most likely to still be in the cache.
+		/// </summary>
+		Game** m_freeGames;
+		int m_freeCount;
+
+		int m_capacity;
+	};
+
+	/// <summary>
+	/// Allocate memory to and initialize a new session pool in the heap, along with every game in it.
+	/// </summary>
+	/// <param name="_capacity">The amount of games in the pool, which is the most sessions that can be running at once.</param>
+	/// <param name="_decks">The amount of full decks in each game's shoe. MUST be from 1 to "c_maxShoeDecks".</param>
+	/// <returns>A pointer to the created pool in memory.</returns>
+	SessionPool* CreateSessionPool(int _capacity, int _decks);
+
+	/// <summary>
+	/// Free the memory allocated to a session pool and every game in it, and nullify its pointer.<br>
+	/// Any game that's still been taken from the pool is ended as well, so nothing can still be using them.
+	/// </summary>
+	/// <param name="_pool">The pool to be de-allocated.</param>
+	void DestroySessionPool(SessionPool*& _pool);
+
+	/// <summary>
+	/// Take a game from the pool, and reset it to be exactly like a newly created game.
+	/// </summary>
+	/// <param name="_pool">The pool to take from.</param>
+	/// <param name="_seed">The seed for the game's generator.</param>
+	/// <returns>The game, or nullptr if every game in the pool is already in use.</returns>
+	Game* AcquireSession(SessionPool* _pool, unsigned long long _seed);
+
+	/// <summary>
+	/// Give a game back to the pool, and nullify its pointer. The game is reset when it's next taken, not now.
+	/// </summary>
+	/// <param name="_pool">The pool the game was taken from.</param>
+	/// <param name="_game">The game to give back.</param>
+	void ReleaseSession(SessionPool* _pool, Game*& _game);
+}
+
+#endif
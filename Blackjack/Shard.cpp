@@ -0,0 +1,184 @@
+#include "Shard.h"
+
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <windows.h>
+
+namespace blackjack
+{
+	/// <summary>
+	/// Work out the settings for a single shard, which are the whole simulation's settings limited to one range of sessions.
+	/// </summary>
+	static SimulationSettings GetShardSettings(const ShardTable* _table, const int _shard)
+	{
+		auto settings = _table->m_settings;
+
+		const auto begin = _table->m_settings.m_sessions * _shard / _table->m_shardCount;
+		const auto end = _table->m_settings.m_sessions * (_shard + 1) / _table->m_shardCount;
+
+		settings.m_firstSession = _table->m_settings.m_firstSession + begin;
+		settings.m_sessions = end - begin;
+
+		// Every shard exports to its own file, named after the original with the shard's index on the end.
+		// A shard that's re-run after a crash overwrites its file, so no rounds are ever exported twice.
+		if (settings.m_exportFormat != EXPORT_FORMAT_NONE)
+		{
+			sprintf_s(settings.m_exportPath, "%s.%d", _table->m_settings.m_exportPath, _shard);
+		}
+
+		return settings;
+	}
+
+	/// <summary>
+	/// Start a new worker process for a shard.
+	/// </summary>
+	/// <returns>A handle to the process, or nullptr if it couldn't be started.</returns>
+	static HANDLE LaunchShardWorker(const char _tableName[], const int _shard)
+	{
+		// Workers are just this same program, started with different arguments.
+		char path[MAX_PATH];
+		GetModuleFileNameA(nullptr, path, MAX_PATH);
+
+		// CreateProcess is allowed to write into the command line, so it can't be a string literal.
+		char commandLine[MAX_PATH * 2];
+		sprintf_s(commandLine, "\"%s\" %s %s %d", path, c_shardArgument, _tableName, _shard);
+
+		STARTUPINFOA startupInfo{};
+		startupInfo.cb = sizeof(startupInfo);
+		PROCESS_INFORMATION processInfo{};
+
+		if (!CreateProcessA(path, commandLine, nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startupInfo, &processInfo))
+		{
+			return nullptr;
+		}
+
+		// Only the process handle is needed to wait on it.
+		CloseHandle(processInfo.hThread);
+		return processInfo.hProcess;
+	}
+
+	bool RunShardedRiskOfRuin(const SimulationSettings* _settings, const int _shards, RuinReport* o_report)
+	{
+		// The segment is named after this process, so that two coordinators running at once can't share one.
+		char tableName[64];
+		sprintf_s(tableName, "Local\\BlackjackShards%lu", GetCurrentProcessId());
+
+		auto* mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(ShardTable), tableName);
+		if (mapping == nullptr)
+		{
+			return false;
+		}
+
+		// New mappings are always zeroed, so every shard starts out incomplete.
+		auto* table = (ShardTable*)MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(ShardTable));
+		if (table == nullptr)
+		{
+			CloseHandle(mapping);
+			return false;
+		}
+
+		table->m_settings = *_settings;
+		table->m_shardCount = _shards;
+
+		// Every process gets an equal share of the machine's threads, unless the caller has asked for a specific amount.
+		if (table->m_settings.m_threads < 1)
+		{
+			const auto threads = (int)std::thread::hardware_concurrency() / _shards;
+			table->m_settings.m_threads = threads > 0 ? threads : 1;
+		}
+
+		HANDLE workers[c_maxShards];
+		for (auto shard = 0; shard < _shards; shard++)
+		{
+			workers[shard] = LaunchShardWorker(tableName, shard);
+		}
+
+		// Every shard's report is reset from the same settings, so their histograms all line up with this one.
+		ResetRuinReport(o_report, _settings);
+
+		auto success = true;
+		for (auto shard = 0; shard < _shards; shard++)
+		{
+			// A shard that crashes is simply run again. Its slot is overwritten, so whatever it left behind doesn't matter.
+			auto attempts = 1;
+			while (true)
+			{
+				DWORD exitCode = 1;
+				if (workers[shard] != nullptr)
+				{
+					WaitForSingleObject(workers[shard], INFINITE);
+					GetExitCodeProcess(workers[shard], &exitCode);
+					CloseHandle(workers[shard]);
+				}
+
+				if (exitCode == 0 && table->m_complete[shard])
+				{
+					MergeRuinReport(o_report, &table->m_reports[shard]);
+					break;
+				}
+
+				if (attempts == c_maxShardAttempts)
+				{
+					std::cout << "Shard " << shard << " failed " << c_maxShardAttempts << " times, and has been left out.\n";
+					success = false;
+					break;
+				}
+
+				workers[shard] = LaunchShardWorker(tableName, shard);
+				attempts++;
+			}
+		}
+
+		UnmapViewOfFile(table);
+		CloseHandle(mapping);
+
+		return success;
+	}
+
+	int RunShardWorker(const char _tableName[], const int _shard)
+	{
+		auto* mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, _tableName);
+		if (mapping == nullptr)
+		{
+			return 1;
+		}
+
+		auto* table = (ShardTable*)MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(ShardTable));
+		if (table == nullptr)
+		{
+			CloseHandle(mapping);
+			return 1;
+		}
+
+		if (_shard < 0 || _shard >= table->m_shardCount)
+		{
+			UnmapViewOfFile(table);
+			CloseHandle(mapping);
+			return 1;
+		}
+
+		const auto settings = GetShardSettings(table, _shard);
+
+		// The report is built in this process's own memory first, and only copied over once it's finished.
+		// That way a crash part way through can never leave a half-written report in the table.
+		auto* report = new RuinReport{};
+		if (!RunRiskOfRuin(&settings, report))
+		{
+			delete report;
+			UnmapViewOfFile(table);
+			CloseHandle(mapping);
+			return 1;
+		}
+
+		table->m_reports[_shard] = *report;
+		MemoryBarrier();
+		table->m_complete[_shard] = 1;
+
+		delete report;
+
+		UnmapViewOfFile(table);
+		CloseHandle(mapping);
+		return 0;
+	}
+}
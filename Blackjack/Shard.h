@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef SHARD_H_
+#define SHARD_H_
+
+#include "Simulation.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The most worker processes a simulation can be split across. This is the most processes Windows can wait on at once.
+	/// </summary>
+	constexpr auto c_maxShards = 64;
+
+	/// <summary>
+	/// How many times a shard is run before the coordinator gives up on it, if its worker keeps crashing.
+	/// </summary>
+	constexpr auto c_maxShardAttempts = 3;
+
+	/// <summary>
+	/// The command line argument that starts the program as a shard worker, rather than opening the menu.<br>
+	/// Workers are started as "Blackjack.exe --shard (table name) (shard index)".
+	/// </summary>
+	constexpr char c_shardArgument[] = "--shard";
+
+	/// <summary>
+	/// Everything the coordinator and its workers share. This lives in a named shared memory segment, never in the heap.<br>
+	/// Every worker only ever writes to its own slot, so no locking is needed.
+	/// </summary>
+	struct ShardTable
+	{
+		/// <summary>
+		/// The settings for the whole simulation. Each worker works out its own range of sessions from these.
+		/// </summary>
+		SimulationSettings m_settings;
+
+		int m_shardCount;
+
+		/// <summary>
+		/// Set by a worker once its report has been completely written. If a worker exits without setting this, it crashed.
+		/// </summary>
+		int m_complete[c_maxShards];
+
+		RuinReport m_reports[c_maxShards];
+	};
+
+	/// <summary>
+	/// Run a risk of ruin simulation split across many worker processes, each with its own disjoint range of sessions.<br>
+	/// If a worker crashes, its shard is run again from scratch. Gives exactly the same results as RunRiskOfRuin.
+	/// </summary>
+	/// <param name="_settings">The settings to run the simulation with. The thread count is per process.</param>
+	/// <param name="_shards">The amount of worker processes. MUST be from 1 to "c_maxShards".</param>
+	/// <param name="o_report">The report to be output into. Anything already in it is overwritten.</param>
+	/// <returns>True if every shard finished. False if the shared table couldn't be made, or if any shard never finished, in which case the report only contains the shards that did.</returns>
+	bool RunShardedRiskOfRuin(const SimulationSettings* _settings, int _shards, RuinReport* o_report);
+
+	/// <summary>
+	/// The main function of a worker process. Runs one shard and writes its report into the shared table.
+	/// </summary>
+	/// <param name="_tableName">The name of the coordinator's shared memory segment.</param>
+	/// <param name="_shard">The index of the shard to run.</param>
+	/// <returns>The process exit code. 0 if the shard was run successfully.</returns>
+	int RunShardWorker(const char _tableName[], int _shard);
+}
+
+#endif
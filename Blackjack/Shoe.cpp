@@ -0,0 +1,231 @@
+#include "Shoe.h"
+
+#include "AllocationTracker.h"
+#include "Tracepoints.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// Wrap a position that has run off the end of the shoe back around to the start.
+	/// </summary>
+	/// <param name="_shoe">The shoe the position is in.</param>
+	/// <param name="_position">A position less than double the shoe's size.</param>
+	/// <returns>The position in the shoe's card array.</returns>
+	static int WrapShoePosition(const Shoe* _shoe, const int _position)
+	{
+		return _position < _shoe->m_size ? _position : _position - _shoe->m_size;
+	}
+
+	/// <summary>
+	/// Swap two cards by their offsets from the start of a range in the shoe.
+	/// </summary>
+	static void SwapShoeCards(Shoe* _shoe, const int _begin, const int _a, const int _b)
+	{
+		auto& a = _shoe->m_cards[WrapShoePosition(_shoe, _begin + _a)];
+		auto& b = _shoe->m_cards[WrapShoePosition(_shoe, _begin + _b)];
+
+		const auto temp = a;
+		a = b;
+		b = temp;
+	}
+
+	/// <summary>
+	/// Get the card stored at an index of a recorded ordering. Indices go through every rank of one suit before moving onto the next.
+	/// </summary>
+	static Card GetOrderedCard(const int _index)
+	{
+		return Card{ (eSuit)(_index / TOTAL_RANKS), (eRank)(_index % TOTAL_RANKS), true };
+	}
+
+	Shoe* GenerateShoe()
+	{
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_GENERATE_SHOE);
+
+		auto* shoe = new Shoe{ {}, 0, 0, 0, 0, 0, false };
+
+		END_ALLOCATION_SCOPE();
+		return shoe;
+	}
+
+	void DestroyShoe(Shoe*& _shoe)
+	{
+		// Cards are stored by value, so there's nothing else to free.
+		delete _shoe;
+		_shoe = nullptr;
+	}
+
+	void PopulateShoe(Shoe* _shoe, const int _decks)
+	{
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_POPULATE_SHOE);
+
+		_shoe->m_size = _decks * c_maxDeckSize;
+		_shoe->m_discardBegin = 0;
+		_shoe->m_discardSize = 0;
+		_shoe->m_inPlaySize = 0;
+		_shoe->m_runningCount = 0;
+
+		for (auto cardIndex = 0; cardIndex < _shoe->m_size; cardIndex++)
+		{
+			_shoe->m_cards[cardIndex] = GetOrderedCard(cardIndex % c_maxDeckSize);
+		}
+
+		END_ALLOCATION_SCOPE();
+	}
+
+	void PopulateShoeInOrder(Shoe* _shoe, const unsigned char _order[], const int _decks)
+	{
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_POPULATE_SHOE);
+
+		_shoe->m_size = _decks * c_maxDeckSize;
+		_shoe->m_discardBegin = 0;
+		_shoe->m_discardSize = 0;
+		_shoe->m_inPlaySize = 0;
+		_shoe->m_runningCount = 0;
+
+		for (auto cardIndex = 0; cardIndex < _shoe->m_size; cardIndex++)
+		{
+			_shoe->m_cards[cardIndex] = GetOrderedCard(_order[cardIndex]);
+		}
+
+		END_ALLOCATION_SCOPE();
+	}
+
+	int GetUndealtSize(const Shoe* _shoe)
+	{
+		return _shoe->m_size - _shoe->m_discardSize - _shoe->m_inPlaySize;
+	}
+
+	int GetTrueCount(const Shoe* _shoe)
+	{
+		const auto undealtSize = GetUndealtSize(_shoe);
+		return undealtSize > 0 ? _shoe->m_runningCount * c_maxDeckSize / undealtSize : 0;
+	}
+
+	Card* DealFromShoe(Shoe* _shoe)
+	{
+		// Dealing is just a cursor bump. The card that's dealt is the one directly after the cards already in play.
+		const auto position = WrapShoePosition(_shoe, _shoe->m_discardBegin + _shoe->m_discardSize + _shoe->m_inPlaySize);
+		_shoe->m_inPlaySize++;
+		_shoe->m_runningCount += c_hiLoValues[_shoe->m_cards[position].m_rank];
+
+		return &_shoe->m_cards[position];
+	}
+
+	Card* DrawFromShoe(Shoe* _shoe, Random* _random)
+	{
+		// Any undealt card can be drawn, since they're all equally random. Swapping it to the front lets DealFromShoe do the rest.
+		const auto begin = _shoe->m_discardBegin + _shoe->m_discardSize + _shoe->m_inPlaySize;
+		SwapShoeCards(_shoe, begin, 0, RandomRange(_random, GetUndealtSize(_shoe)));
+
+		return DealFromShoe(_shoe);
+	}
+
+	void DiscardInPlay(Shoe* _shoe)
+	{
+		if (_shoe->m_continuous)
+		{
+			// The discard pile is always empty, so the cards in play sit directly before the undealt cards, which wrap around to them.
+			// Moving the start of the discard pile past them puts them on the end of the undealt cards. Their order doesn't matter.
+			_shoe->m_discardBegin = WrapShoePosition(_shoe, _shoe->m_discardBegin + _shoe->m_inPlaySize);
+			_shoe->m_inPlaySize = 0;
+
+			// Every card is undealt again, so there's nothing left to count.
+			_shoe->m_runningCount = 0;
+			return;
+		}
+
+		// The cards in play sit directly after the discard pile, so growing the pile over them discards the lot.
+		_shoe->m_discardSize += _shoe->m_inPlaySize;
+		_shoe->m_inPlaySize = 0;
+	}
+
+	void ShuffleShoe(Shoe* _shoe, Random* _random)
+	{
+		TRACEPOINT_SHUFFLE_SHOE(GetUndealtSize(_shoe));
+
+		const auto begin = _shoe->m_discardBegin + _shoe->m_discardSize + _shoe->m_inPlaySize;
+
+		// Fisher-Yates, so every ordering is equally likely.
+		for (auto cardIndex = GetUndealtSize(_shoe) - 1; cardIndex > 0; cardIndex--)
+		{
+			SwapShoeCards(_shoe, begin, cardIndex, RandomRange(_random, cardIndex + 1));
+		}
+	}
+
+	void ShuffleShoe(Shoe* _shoe, const unsigned short _swaps[])
+	{
+		TRACEPOINT_SHUFFLE_SHOE(GetUndealtSize(_shoe));
+
+		const auto begin = _shoe->m_discardBegin + _shoe->m_discardSize + _shoe->m_inPlaySize;
+
+		for (auto cardIndex = GetUndealtSize(_shoe) - 1; cardIndex > 0; cardIndex--)
+		{
+			SwapShoeCards(_shoe, begin, cardIndex, _swaps[cardIndex]);
+		}
+	}
+
+	/// <summary>
+	/// Once the discard pile has been shuffled, the ranges are moved so that it becomes the undealt cards.
+	/// </summary>
+	static void FinishReshuffle(Shoe* _shoe)
+	{
+		// Every card has been dealt, so the old discard pile is what comes after the cards in play.
+		// The new discard pile is empty, and starts directly before the cards in play.
+		_shoe->m_discardBegin = WrapShoePosition(_shoe, _shoe->m_discardBegin + _shoe->m_discardSize);
+		_shoe->m_discardSize = 0;
+
+		// The count starts again from the shuffle, except for the cards still in play, which have been seen but aren't coming back yet.
+		_shoe->m_runningCount = 0;
+		for (auto cardIndex = 0; cardIndex < _shoe->m_inPlaySize; cardIndex++)
+		{
+			_shoe->m_runningCount += c_hiLoValues[_shoe->m_cards[WrapShoePosition(_shoe, _shoe->m_discardBegin + cardIndex)].m_rank];
+		}
+	}
+
+	void ReshuffleDiscard(Shoe* _shoe, Random* _random)
+	{
+		for (auto cardIndex = _shoe->m_discardSize - 1; cardIndex > 0; cardIndex--)
+		{
+			SwapShoeCards(_shoe, _shoe->m_discardBegin, cardIndex, RandomRange(_random, cardIndex + 1));
+		}
+
+		FinishReshuffle(_shoe);
+	}
+
+	void ReshuffleDiscard(Shoe* _shoe, const unsigned short _swaps[])
+	{
+		// Each swap target is independent of the size being shuffled, so only the first m_discardSize of them are needed.
+		for (auto cardIndex = _shoe->m_discardSize - 1; cardIndex > 0; cardIndex--)
+		{
+			SwapShoeCards(_shoe, _shoe->m_discardBegin, cardIndex, _swaps[cardIndex]);
+		}
+
+		FinishReshuffle(_shoe);
+	}
+
+	void ReshuffleDiscardInOrder(Shoe* _shoe, const unsigned char _order[])
+	{
+		// Count how many copies of each card are still in play, since those have to be left out of the discard pile.
+		int inPlay[c_maxDeckSize] = {};
+		for (auto cardIndex = 0; cardIndex < _shoe->m_inPlaySize; cardIndex++)
+		{
+			const auto& card = _shoe->m_cards[WrapShoePosition(_shoe, _shoe->m_discardBegin + _shoe->m_discardSize + cardIndex)];
+			inPlay[card.m_suit * TOTAL_RANKS + card.m_rank]++;
+		}
+
+		// Every card has been dealt, so the discard pile is every card that isn't in play, and the ordering fills it exactly.
+		auto position = 0;
+		for (auto orderIndex = 0; orderIndex < _shoe->m_size; orderIndex++)
+		{
+			if (inPlay[_order[orderIndex]] > 0)
+			{
+				inPlay[_order[orderIndex]]--;
+				continue;
+			}
+
+			_shoe->m_cards[WrapShoePosition(_shoe, _shoe->m_discardBegin + position++)] = GetOrderedCard(_order[orderIndex]);
+		}
+
+		FinishReshuffle(_shoe);
+	}
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#ifndef SHOE_H_
+#define SHOE_H_
+
+#include "Card.h"
+#include "Random.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The amount of cards in one full deck.
+	/// </summary>
+	constexpr int c_maxDeckSize = TOTAL_SUITS * TOTAL_RANKS;
+
+	/// <summary>
+	/// The most full decks that can be loaded into one shoe.
+	/// </summary>
+	constexpr auto c_maxShoeDecks = 8;
+
+	/// <summary>
+	/// The most cards that can be loaded into one shoe.
+	/// </summary>
+	constexpr auto c_maxShoeSize = c_maxDeckSize * c_maxShoeDecks;
+
+	/// <summary>
+	/// The Hi-Lo counting value of every rank. Low cards leaving the shoe are good for the player, high cards are bad.
+	/// </summary>
+	constexpr int c_hiLoValues[] = { -1, 1, 1, 1, 1, 1, 0, 0, 0, -1, -1, -1, -1, 0 };
+
+	/// <summary>
+	/// Every card in the game, stored in one contiguous array. Cards never move between containers, only between ranges.<br>
+	/// The array is treated as a ring, split into three ranges in this order: the discard pile, the cards in play, and the undealt cards.
+	/// The undealt range then wraps back around to the start of the discard pile.<br>
+	/// A continuous shoe never has a discard pile, as discarded cards go straight back into the undealt range.
+	/// </summary>
+	struct Shoe
+	{
+		Card m_cards[c_maxShoeSize];
+
+		/// <summary>
+		/// The amount of cards in the shoe, across all three ranges.
+		/// </summary>
+		int m_size;
+
+		/// <summary>
+		/// The position of the first card in the discard pile. The cards in play start directly after the discard pile.
+		/// </summary>
+		int m_discardBegin;
+		int m_discardSize;
+
+		/// <summary>
+		/// The amount of cards that have been dealt since the last discard. The next card to deal is directly after these.
+		/// </summary>
+		int m_inPlaySize;
+
+		/// <summary>
+		/// The Hi-Lo running count of every card dealt since the last shuffle, kept up to date as cards are dealt.
+		/// </summary>
+		int m_runningCount;
+
+		/// <summary>
+		/// Whether this shoe is a continuous shuffling machine. If so, cards must be dealt with DrawFromShoe, never DealFromShoe.
+		/// </summary>
+		bool m_continuous;
+	};
+
+	/// <summary>
+	/// Allocate memory to and create a new, empty shoe in the heap.
+	/// </summary>
+	/// <returns>A pointer to the created shoe in memory.</returns>
+	Shoe* GenerateShoe();
+
+	/// <summary>
+	/// Free the memory allocated to a shoe stored in the heap, and nullify its pointer.<br>
+	/// Any hands still pointing at this shoe's cards must not be used afterwards.
+	/// </summary>
+	/// <param name="_shoe">The shoe to be de-allocated.</param>
+	void DestroyShoe(Shoe*& _shoe);
+
+	/// <summary>
+	/// Fill a shoe with one copy of every single card per deck, all undealt and in order.
+	/// </summary>
+	/// <param name="_shoe">The shoe to be populated.</param>
+	/// <param name="_decks">The amount of full decks to load. MUST be from 1 to "c_maxShoeDecks".</param>
+	void PopulateShoe(Shoe* _shoe, int _decks);
+
+	/// <summary>
+	/// Fill a shoe with a recorded ordering of cards, all undealt, so they're dealt in exactly that order without being shuffled.
+	/// </summary>
+	/// <param name="_shoe">The shoe to be populated.</param>
+	/// <param name="_order">Every card in the order it's dealt, each stored as "suit * TOTAL_RANKS + rank". MUST hold every card of every deck once.</param>
+	/// <param name="_decks">The amount of full decks in the ordering. MUST be from 1 to "c_maxShoeDecks".</param>
+	void PopulateShoeInOrder(Shoe* _shoe, const unsigned char _order[], int _decks);
+
+	/// <summary>
+	/// Get the amount of cards that are left to be dealt.
+	/// </summary>
+	/// <param name="_shoe">The shoe to check.</param>
+	/// <returns>The amount of undealt cards.</returns>
+	int GetUndealtSize(const Shoe* _shoe);
+
+	/// <summary>
+	/// Get the Hi-Lo true count, which is the running count per deck left to be dealt.
+	/// </summary>
+	/// <param name="_shoe">The shoe to check.</param>
+	/// <returns>The true count, rounded towards zero.</returns>
+	int GetTrueCount(const Shoe* _shoe);
+
+	/// <summary>
+	/// Deal the next card out of the shoe, moving it into play. The card itself stays exactly where it is.
+	/// </summary>
+	/// <param name="_shoe">The shoe to deal from. MUST have at least one undealt card.</param>
+	/// <returns>A pointer to the dealt card, which stays valid until the card is discarded and reshuffled.</returns>
+	Card* DealFromShoe(Shoe* _shoe);
+
+	/// <summary>
+	/// Deal a random undealt card out of a continuous shoe, moving it into play.<br>
+	/// The card is swapped into the next position to deal first, so this costs the same as DealFromShoe and never needs a shuffle.
+	/// </summary>
+	/// <param name="_shoe">The shoe to deal from. MUST have at least one undealt card.</param>
+	/// <param name="_random">The generator to choose the card with.</param>
+	/// <returns>A pointer to the dealt card, which stays valid until the card is discarded.</returns>
+	Card* DrawFromShoe(Shoe* _shoe, Random* _random);
+
+	/// <summary>
+	/// Move every card that is in play onto the discard pile.<br>
+	/// In a continuous shoe, they go straight back in with the undealt cards instead.
+	/// </summary>
+	/// <param name="_shoe">The shoe to discard in.</param>
+	void DiscardInPlay(Shoe* _shoe);
+
+	/// <summary>
+	/// Randomly shuffle every undealt card in the shoe. Cards in play and in the discard pile are left alone.
+	/// </summary>
+	/// <param name="_shoe">The shoe to be shuffled.</param>
+	/// <param name="_random">The generator to shuffle with.</param>
+	void ShuffleShoe(Shoe* _shoe, Random* _random);
+
+	/// <summary>
+	/// Randomly shuffle every undealt card in the shoe using pre-generated swaps. Cards in play and in the discard pile are left alone.
+	/// </summary>
+	/// <param name="_shoe">The shoe to be shuffled.</param>
+	/// <param name="_swaps">Fisher-Yates swap targets, where _swaps[i] is a random position from 0 to i (inclusive).</param>
+	void ShuffleShoe(Shoe* _shoe, const unsigned short _swaps[]);
+
+	/// <summary>
+	/// Shuffle the discard pile in place, and make it the undealt cards. Should only be done once every card has been dealt.
+	/// </summary>
+	/// <param name="_shoe">The shoe to be reshuffled.</param>
+	/// <param name="_random">The generator to shuffle with.</param>
+	void ReshuffleDiscard(Shoe* _shoe, Random* _random);
+
+	/// <summary>
+	/// Shuffle the discard pile in place using pre-generated swaps, and make it the undealt cards.
+	/// </summary>
+	/// <param name="_shoe">The shoe to be reshuffled.</param>
+	/// <param name="_swaps">Fisher-Yates swap targets, where _swaps[i] is a random position from 0 to i (inclusive).</param>
+	void ReshuffleDiscard(Shoe* _shoe, const unsigned short _swaps[]);
+
+	/// <summary>
+	/// Put the discard pile into a recorded ordering instead of shuffling it, and make it the undealt cards.<br>
+	/// The cards still in play aren't in the discard pile, so one copy of each of them is skipped over in the ordering.
+	/// </summary>
+	/// <param name="_shoe">The shoe to be reshuffled.</param>
+	/// <param name="_order">Every card of the whole shoe, stored the same way as for PopulateShoeInOrder.</param>
+	void ReshuffleDiscardInOrder(Shoe* _shoe, const unsigned char _order[]);
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include "ShoeLibrary.h"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+#include "Random.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// Check that an ordering holds exactly one copy of every card per deck, and nothing else.
+	/// </summary>
+	static bool IsShoeOrderValid(const unsigned char _order[], const int _decks)
+	{
+		int copies[c_maxDeckSize] = {};
+		for (auto cardIndex = 0; cardIndex < _decks * c_maxDeckSize; cardIndex++)
+		{
+			if (_order[cardIndex] >= c_maxDeckSize || ++copies[_order[cardIndex]] > _decks)
+			{
+				return false;
+			}
+		}
+
+		// No card has more copies than there are decks, and there are exactly enough cards for every one of them, so none can have fewer.
+		return true;
+	}
+
+	ShoeLibrary* OpenShoeLibrary(const char _path[])
+	{
+		// The library is only ever read, so every process dealing from it shares the same pages.
+		auto* file = OpenMappedFile(_path, 0, false);
+		if (file == nullptr)
+		{
+			return nullptr;
+		}
+
+		const auto* header = (const ShoeLibraryHeader*)file->m_view;
+		auto valid = file->m_size >= (long long)sizeof(ShoeLibraryHeader) && memcmp(header->m_magic, c_shoeLibraryMagic, sizeof(c_shoeLibraryMagic)) == 0 &&
+			header->m_version == c_shoeLibraryVersion && header->m_decks >= 1 && header->m_decks <= c_maxShoeDecks && header->m_shoes >= 1;
+
+		const auto shoeSize = valid ? header->m_decks * c_maxDeckSize : 0;
+		valid = valid && (file->m_size - (long long)sizeof(ShoeLibraryHeader)) / shoeSize >= header->m_shoes;
+
+		// Every ordering is checked once here, so that dealing from them never has to. This is one pass straight through the file.
+		const auto* orders = file->m_view + sizeof(ShoeLibraryHeader);
+		for (auto shoe = 0ll; valid && shoe < header->m_shoes; shoe++)
+		{
+			valid = IsShoeOrderValid(orders + shoe * shoeSize, header->m_decks);
+		}
+
+		if (!valid)
+		{
+			CloseMappedFile(file);
+			return nullptr;
+		}
+
+		return new ShoeLibrary{ file, orders, header->m_decks, shoeSize, header->m_shoes };
+	}
+
+	void CloseShoeLibrary(ShoeLibrary*& _library)
+	{
+		CloseMappedFile(_library->m_file);
+
+		delete _library;
+		_library = nullptr;
+	}
+
+	const unsigned char* GetLibraryShoe(const ShoeLibrary* _library, const long long _index)
+	{
+		return _library->m_orders + _index % _library->m_shoes * _library->m_shoeSize;
+	}
+
+	long long GetSessionLibraryShoes(const int _decks, const int _maxRounds)
+	{
+		// The shoe is only reshuffled once it's empty, so every ordering is dealt all the way through. The first shoe is populated rather than
+		// reshuffled, which is the one on the end. Sessions that play longer than expected only share their last few shoes with the next one.
+		const auto shoeSize = (long long)_decks * c_maxDeckSize;
+		return ((long long)_maxRounds * c_libraryCardsPerRound + shoeSize - 1) / shoeSize + 1;
+	}
+
+	bool GenerateShoeLibrary(const char _path[], const long long _shoes, const int _decks, const unsigned long long _seed)
+	{
+		const auto shoeSize = _decks * c_maxDeckSize;
+
+		auto* file = OpenMappedFile(_path, (long long)sizeof(ShoeLibraryHeader) + _shoes * shoeSize, true);
+		if (file == nullptr)
+		{
+			return false;
+		}
+
+		// The magic is cleared first, so that an overwritten file isn't mistaken for a complete one if this is stopped part way through.
+		auto* header = (ShoeLibraryHeader*)file->m_view;
+		memset(header->m_magic, 0, sizeof(header->m_magic));
+		header->m_version = c_shoeLibraryVersion;
+		header->m_decks = _decks;
+		header->m_shoes = _shoes;
+
+		Random random{};
+		SeedRandom(&random, _seed);
+
+		// Each ordering is written straight into the mapping, starting in order and then shuffled with Fisher-Yates, just like the game's shoe.
+		auto* order = file->m_view + sizeof(ShoeLibraryHeader);
+		for (auto shoe = 0ll; shoe < _shoes; shoe++, order += shoeSize)
+		{
+			for (auto cardIndex = 0; cardIndex < shoeSize; cardIndex++)
+			{
+				order[cardIndex] = (unsigned char)(cardIndex % c_maxDeckSize);
+			}
+
+			for (auto cardIndex = shoeSize - 1; cardIndex > 0; cardIndex--)
+			{
+				const auto swapIndex = RandomRange(&random, cardIndex + 1);
+				const auto temp = order[cardIndex];
+				order[cardIndex] = order[swapIndex];
+				order[swapIndex] = temp;
+			}
+		}
+
+		memcpy(header->m_magic, c_shoeLibraryMagic, sizeof(c_shoeLibraryMagic));
+
+		CloseMappedFile(file);
+		return true;
+	}
+
+	int RunGenerateShoesCommand(const char _path[], const long long _shoes, const int _decks, const unsigned long long _seed)
+	{
+		if (_shoes < 1 || _decks < 1 || _decks > c_maxShoeDecks)
+		{
+			std::cout << "A library needs at least 1 shoe, each with from 1 to " << c_maxShoeDecks << " decks.\n";
+			return 1;
+		}
+
+		const auto start = std::chrono::steady_clock::now();
+
+		if (!GenerateShoeLibrary(_path, _shoes, _decks, _seed))
+		{
+			std::cout << "Could not open " << _path << " for writing!\n";
+			return 1;
+		}
+
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		std::cout << "Wrote " << _shoes << " shoes of " << _decks << " decks to " << _path << " (seed " << _seed << ") in " <<
+			std::fixed << std::setprecision(2) << elapsed.count() << " seconds.\n";
+		return 0;
+	}
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#ifndef SHOE_LIBRARY_H_
+#define SHOE_LIBRARY_H_
+
+#include "MappedFile.h"
+#include "Shoe.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The file simulations deal recorded shoes from, next to wherever the program is run from.
+	/// </summary>
+	constexpr char c_shoeLibraryFileName[] = "shoes.bjo";
+
+	/// <summary>
+	/// The command line argument that fills a library with randomly shuffled shoes instead of opening the menu.<br>
+	/// It's followed by the file's path, the amount of shoes, the amount of decks in each, and optionally a seed.
+	/// </summary>
+	constexpr char c_generateShoesArgument[] = "--generate-shoes";
+
+	/// <summary>
+	/// Roughly how many cards a simulated round deals, a little over the usual heads-up average to leave room for splits and doubles.<br>
+	/// Used to work out how many shoes a session deals, so that sessions can each start on their own run of shoes.
+	/// </summary>
+	constexpr auto c_libraryCardsPerRound = 6;
+
+	/// <summary>
+	/// The identifier at the very start of every library file.
+	/// </summary>
+	constexpr char c_shoeLibraryMagic[8] = { 'B', 'J', 'S', 'H', 'O', 'E', '1', 0 };
+
+	/// <summary>
+	/// Changed whenever the layout of the library file changes. Files from other versions can't be opened.
+	/// </summary>
+	constexpr auto c_shoeLibraryVersion = 1;
+
+	/// <summary>
+	/// The header at the very start of every library file.<br>
+	/// After it come "m_shoes" orderings, each one byte per card in the order they're dealt, stored as "suit * TOTAL_RANKS + rank".
+	/// </summary>
+	struct ShoeLibraryHeader
+	{
+		/// <summary>
+		/// Only written once every ordering is, so a file with this set is complete.
+		/// </summary>
+		char m_magic[8];
+
+		int m_version;
+		int m_decks;
+		long long m_shoes;
+	};
+
+	/// <summary>
+	/// A memory-mapped file of recorded shoe orderings. Shoes are dealt straight out of the mapping, so nothing is ever copied or parsed.<br>
+	/// The library is only ever read, so any amount of games, threads, and processes can share it.
+	/// </summary>
+	struct ShoeLibrary
+	{
+		MappedFile* m_file;
+
+		/// <summary>
+		/// The first ordering in the mapping. Each ordering is "m_shoeSize" bytes long, directly after the one before it.
+		/// </summary>
+		const unsigned char* m_orders;
+
+		int m_decks;
+		int m_shoeSize;
+		long long m_shoes;
+	};
+
+	/// <summary>
+	/// Open and map a library file, checking every ordering in it holds exactly one copy of every card per deck.<br>
+	/// Once it's open, every ordering is known to be valid, so games can deal from it without checking anything.
+	/// </summary>
+	/// <param name="_path">The path of the library file.</param>
+	/// <returns>A pointer to the library in memory, or nullptr if it couldn't be opened, isn't complete, or holds an invalid ordering.</returns>
+	ShoeLibrary* OpenShoeLibrary(const char _path[]);
+
+	/// <summary>
+	/// Unmap a library file, then free the memory allocated to it and nullify its pointer.<br>
+	/// No game can still be dealing from the library afterwards.
+	/// </summary>
+	/// <param name="_library">The library to be closed.</param>
+	void CloseShoeLibrary(ShoeLibrary*& _library);
+
+	/// <summary>
+	/// Get one of the orderings in a library. Indices past the last ordering wrap back around to the first.
+	/// </summary>
+	/// <param name="_library">The library to get the ordering from.</param>
+	/// <param name="_index">The index of the ordering.</param>
+	/// <returns>A pointer to the ordering inside the mapping, ready for PopulateShoeInOrder or ReshuffleDiscardInOrder.</returns>
+	const unsigned char* GetLibraryShoe(const ShoeLibrary* _library, long long _index);
+
+	/// <summary>
+	/// Get how many orderings a simulated session is expected to deal at most, so that each session can start that many orderings after the last.<br>
+	/// Sessions that start one ordering apart would otherwise deal each other's shoes, one shoe out of step, and stop being independent.
+	/// </summary>
+	/// <param name="_decks">The amount of full decks in each ordering.</param>
+	/// <param name="_maxRounds">The most rounds a session can last.</param>
+	/// <returns>The amount of orderings between the first shoes of two sessions next to each other. At least 1.</returns>
+	long long GetSessionLibraryShoes(int _decks, int _maxRounds);
+
+	/// <summary>
+	/// Write a library file of randomly shuffled shoes. Every ordering is equally likely, just like a shoe shuffled by the game.
+	/// </summary>
+	/// <param name="_path">The path of the library file. An existing file is overwritten.</param>
+	/// <param name="_shoes">The amount of orderings to write.</param>
+	/// <param name="_decks">The amount of full decks in each ordering. MUST be from 1 to "c_maxShoeDecks".</param>
+	/// <param name="_seed">The seed to shuffle with. The same seed will always produce the same library.</param>
+	/// <returns>False if the file couldn't be opened or grown.</returns>
+	bool GenerateShoeLibrary(const char _path[], long long _shoes, int _decks, unsigned long long _seed);
+
+	/// <summary>
+	/// Read a library's size from the command line, generate it, and display how long it took.
+	/// </summary>
+	/// <param name="_path">The path of the library file.</param>
+	/// <param name="_shoes">The amount of orderings to write.</param>
+	/// <param name="_decks">The amount of full decks in each ordering.</param>
+	/// <param name="_seed">The seed to shuffle with.</param>
+	/// <returns>The program's exit code. 0 if the library was written, 1 if not.</returns>
+	int RunGenerateShoesCommand(const char _path[], long long _shoes, int _decks, unsigned long long _seed);
+}
+
+#endif
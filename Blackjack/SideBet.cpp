@@ -0,0 +1,129 @@
+#include "SideBet.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The amount of distinct cards, i.e. every rank in every suit.
+	/// </summary>
+	constexpr auto c_distinctCards = TOTAL_RANKS * TOTAL_SUITS;
+
+	/// <summary>
+	/// The result of every side bet for every combination of cards it can be settled with.
+	/// </summary>
+	struct SideBetTables
+	{
+		/// <summary>
+		/// Indexed by both of the player's cards, as given by GetCardIndex.
+		/// </summary>
+		eSideBetResult m_perfectPairs[c_distinctCards][c_distinctCards];
+
+		/// <summary>
+		/// Indexed by whether all three cards share a suit, then by each card's rank. Suits only matter for flushes, so they aren't needed otherwise.
+		/// </summary>
+		eSideBetResult m_twentyOnePlusThree[2][TOTAL_RANKS][TOTAL_RANKS][TOTAL_RANKS];
+	};
+
+	/// <summary>
+	/// Get where a card is in the tables. Every rank and suit gives a different index.
+	/// </summary>
+	constexpr int GetCardIndex(const eRank _rank, const eSuit _suit)
+	{
+		return _rank * TOTAL_SUITS + _suit;
+	}
+
+	/// <summary>
+	/// Hearts and Diamonds are red, and Clubs and Spades are black.
+	/// </summary>
+	constexpr int GetSuitColour(const int _suit)
+	{
+		return _suit / 2;
+	}
+
+	/// <summary>
+	/// Work out the result of every combination of cards, for both side bets. This is only ever evaluated while compiling.
+	/// </summary>
+	constexpr SideBetTables GenerateSideBetTables()
+	{
+		SideBetTables tables{};
+
+		for (auto first = 0; first < c_distinctCards; first++)
+		{
+			for (auto second = 0; second < c_distinctCards; second++)
+			{
+				const auto firstSuit = first % TOTAL_SUITS;
+				const auto secondSuit = second % TOTAL_SUITS;
+
+				auto result = SIDE_BET_RESULT_NONE;
+				if (first / TOTAL_SUITS == second / TOTAL_SUITS)
+				{
+					result = firstSuit == secondSuit ? SIDE_BET_RESULT_PERFECT_PAIR :
+						GetSuitColour(firstSuit) == GetSuitColour(secondSuit) ? SIDE_BET_RESULT_COLOURED_PAIR : SIDE_BET_RESULT_MIXED_PAIR;
+				}
+
+				tables.m_perfectPairs[first][second] = result;
+			}
+		}
+
+		for (auto first = 0; first < TOTAL_RANKS; first++)
+		{
+			for (auto second = 0; second < TOTAL_RANKS; second++)
+			{
+				for (auto third = 0; third < TOTAL_RANKS; third++)
+				{
+					// Sort the ranks, so a straight is just three ranks in a row.
+					auto low = first < second ? first : second;
+					auto high = first < second ? second : first;
+					auto middle = third;
+					if (third < low)
+					{
+						middle = low;
+						low = third;
+					}
+					else if (third > high)
+					{
+						middle = high;
+						high = third;
+					}
+
+					// Aces can be high as well as low, so Queen, King, Ace is a straight too.
+					const auto trips = low == high;
+					const auto straight = (middle == low + 1 && high == middle + 1) || (low == RANK_ACE && middle == RANK_QUEEN && high == RANK_KING);
+
+					tables.m_twentyOnePlusThree[0][first][second][third] =
+						trips ? SIDE_BET_RESULT_THREE_OF_A_KIND : straight ? SIDE_BET_RESULT_STRAIGHT : SIDE_BET_RESULT_NONE;
+					tables.m_twentyOnePlusThree[1][first][second][third] =
+						trips ? SIDE_BET_RESULT_SUITED_TRIPS : straight ? SIDE_BET_RESULT_STRAIGHT_FLUSH : SIDE_BET_RESULT_FLUSH;
+				}
+			}
+		}
+
+		return tables;
+	}
+
+	constexpr SideBetTables c_sideBetTables = GenerateSideBetTables();
+
+	// A few hands that are easy to check by eye. If any of these are wrong, the generator is broken.
+	static_assert(c_sideBetTables.m_perfectPairs[GetCardIndex(RANK_KING, SUIT_HEARTS)][GetCardIndex(RANK_KING, SUIT_DIAMONDS)] == SIDE_BET_RESULT_COLOURED_PAIR,
+		"Two red Kings should be a coloured pair.");
+	static_assert(c_sideBetTables.m_twentyOnePlusThree[1][RANK_KING][RANK_ACE][RANK_QUEEN] == SIDE_BET_RESULT_STRAIGHT_FLUSH,
+		"Queen, King, Ace of one suit should be a straight flush.");
+	static_assert(c_sideBetTables.m_twentyOnePlusThree[0][RANK_KING][RANK_ACE][RANK_TWO] == SIDE_BET_RESULT_NONE,
+		"Straights shouldn't wrap around from King to Two.");
+
+	eSideBetResult GetPerfectPairsResult(const Card _first, const Card _second)
+	{
+		return c_sideBetTables.m_perfectPairs[GetCardIndex(_first.m_rank, _first.m_suit)][GetCardIndex(_second.m_rank, _second.m_suit)];
+	}
+
+	eSideBetResult GetTwentyOnePlusThreeResult(const Card _first, const Card _second, const Card _upcard)
+	{
+		const auto flush = (_first.m_suit == _second.m_suit) & (_second.m_suit == _upcard.m_suit);
+		return c_sideBetTables.m_twentyOnePlusThree[flush][_first.m_rank][_second.m_rank][_upcard.m_rank];
+	}
+
+	int GetSideBetPayout(const eSideBetResult _result, const int _bet)
+	{
+		// A losing result has odds of 0, which pays nothing rather than the bet back, so it has to be told apart.
+		return _result == SIDE_BET_RESULT_NONE ? 0 : _bet * (c_sideBetOdds[_result] + 1);
+	}
+}
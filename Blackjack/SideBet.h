@@ -0,0 +1,84 @@
+#pragma once
+
+#ifndef SIDE_BET_H_
+#define SIDE_BET_H_
+
+#include "Card.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// Every side bet a player can make alongside their main bet. Both are settled using only the initial deal.<br>
+	/// Includes a value to refer to for the total amount of side bets, which should not be assigned to a bet ever.
+	/// </summary>
+	enum eSideBet : int
+	{
+		SIDE_BET_PERFECT_PAIRS = 0,
+		SIDE_BET_TWENTY_ONE_PLUS_THREE,
+		TOTAL_SIDE_BETS
+	};
+
+	/// <summary>
+	/// String values for every side bet name.<br>
+	/// Includes an additional blank value for the TOTAL_SIDE_BETS value, just in-case.
+	/// </summary>
+	constexpr char c_sideBetNames[][14] = { "Perfect Pairs", "21+3", "" };
+
+	/// <summary>
+	/// Every way a side bet can be won, for both side bets. Perfect Pairs only ever gives the pairs, and 21+3 only ever gives the rest.<br>
+	/// Includes a value to refer to for the total amount of results, which should not be assigned to a result ever.
+	/// </summary>
+	enum eSideBetResult : unsigned char
+	{
+		SIDE_BET_RESULT_NONE = 0,
+		SIDE_BET_RESULT_MIXED_PAIR,
+		SIDE_BET_RESULT_COLOURED_PAIR,
+		SIDE_BET_RESULT_PERFECT_PAIR,
+		SIDE_BET_RESULT_FLUSH,
+		SIDE_BET_RESULT_STRAIGHT,
+		SIDE_BET_RESULT_THREE_OF_A_KIND,
+		SIDE_BET_RESULT_STRAIGHT_FLUSH,
+		SIDE_BET_RESULT_SUITED_TRIPS,
+		TOTAL_SIDE_BET_RESULTS
+	};
+
+	/// <summary>
+	/// String values for every side bet result name.<br>
+	/// Includes an additional blank value for the TOTAL_SIDE_BET_RESULTS value, just in-case.
+	/// </summary>
+	constexpr char c_sideBetResultNames[][16] = { "Nothing", "Mixed Pair", "Coloured Pair", "Perfect Pair", "Flush", "Straight",
+		"Three of a Kind", "Straight Flush", "Suited Trips", "" };
+
+	/// <summary>
+	/// What each result pays, to 1. Losing side bets pay nothing at all.
+	/// </summary>
+	constexpr int c_sideBetOdds[] = { 0, 6, 12, 25, 5, 10, 30, 40, 100, 0 };
+
+	/// <summary>
+	/// Settle Perfect Pairs from the player's first two cards. Every combination is worked out while compiling, so this is a single read.
+	/// </summary>
+	/// <param name="_first">The player's first card.</param>
+	/// <param name="_second">The player's second card.</param>
+	/// <returns>The best pair the cards make, or SIDE_BET_RESULT_NONE if they aren't a pair.</returns>
+	eSideBetResult GetPerfectPairsResult(Card _first, Card _second);
+
+	/// <summary>
+	/// Settle 21+3 from the player's first two cards and the dealer's face-up card, as a three card poker hand.<br>
+	/// Every combination is worked out while compiling, so this is a single read.
+	/// </summary>
+	/// <param name="_first">The player's first card.</param>
+	/// <param name="_second">The player's second card.</param>
+	/// <param name="_upcard">The dealer's face-up card.</param>
+	/// <returns>The best hand the cards make, or SIDE_BET_RESULT_NONE if they don't make one.</returns>
+	eSideBetResult GetTwentyOnePlusThreeResult(Card _first, Card _second, Card _upcard);
+
+	/// <summary>
+	/// Get how much money is paid back for a side bet, including the bet itself.
+	/// </summary>
+	/// <param name="_result">The side bet's result.</param>
+	/// <param name="_bet">The amount of money put on the side bet.</param>
+	/// <returns>The total amount paid back. 0 if the side bet lost.</returns>
+	int GetSideBetPayout(eSideBetResult _result, int _bet);
+}
+
+#endif
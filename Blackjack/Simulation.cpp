@@ -0,0 +1,773 @@
+#include "Simulation.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "IO.h"
+#include "Lockstep.h"
+#include "Shard.h"
+#include "ShoeLibrary.h"
+#include "Strategy.h"
+#include "Tracepoints.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// Get which histogram bucket a value falls into. Values past the maximum are put in the last bucket.
+	/// </summary>
+	static int GetHistogramBucket(const long long _value, const long long _maxValue)
+	{
+		const auto bucket = _value * c_histogramSize / (_maxValue + 1);
+		return bucket < c_histogramSize ? (int)bucket : c_histogramSize - 1;
+	}
+
+	/// <summary>
+	/// Estimate a quantile from a histogram, using the middle of whichever bucket it falls in.
+	/// </summary>
+	/// <param name="_histogram">The histogram to read.</param>
+	/// <param name="_quantile">The quantile to find, from 0 to 1.</param>
+	/// <param name="_maxValue">The maximum value the histogram was filled with.</param>
+	/// <returns>The estimated value, or 0 if the histogram is empty.</returns>
+	static double GetHistogramQuantile(const long long _histogram[], const double _quantile, const long long _maxValue)
+	{
+		long long total = 0;
+		for (auto bucket = 0; bucket < c_histogramSize; bucket++)
+		{
+			total += _histogram[bucket];
+		}
+
+		const auto target = (long long)(_quantile * (double)total);
+
+		long long seen = 0;
+		for (auto bucket = 0; bucket < c_histogramSize; bucket++)
+		{
+			seen += _histogram[bucket];
+			if (seen > target)
+			{
+				return ((double)bucket + 0.5) * (double)(_maxValue + 1) / c_histogramSize;
+			}
+		}
+
+		return 0;
+	}
+
+	/// <summary>
+	/// Seed every sketch in a report, each with its own stream derived from the same seed.
+	/// </summary>
+	static void SeedRuinSketches(RuinReport* _report, const unsigned long long _seed)
+	{
+		ResetQuantileSketch(&_report->m_finalBanks, DeriveSeed(_seed, 0));
+		ResetQuantileSketch(&_report->m_sessionRounds, DeriveSeed(_seed, 1));
+		ResetQuantileSketch(&_report->m_maxDrawdowns, DeriveSeed(_seed, 2));
+	}
+
+	/// <summary>
+	/// A worker thread's main function. Claims batches of sessions until there are none left, adding them to its own report.
+	/// </summary>
+	static void RunRuinWorker(const SimulationSettings* _settings, std::atomic<long long>* _nextSession, ExportWriter* _writer, const ShoeLibrary* _library,
+		RuinReport* o_report)
+	{
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+		// Snapshots are taken around the worker's setup, each session, and each window of rounds, so every allocation can be pinned down.
+		AllocationReport workerStart, sessionStart, windowStart, allocations;
+		GetAllocationReport(&workerStart);
+#endif
+
+		// Each worker only ever needs one game, which is reset between sessions. Memory use doesn't grow with the session count.
+		auto* game = InitGame(false, _settings->m_decks, false);
+		game->m_shoe->m_continuous = _settings->m_continuousShuffle;
+		auto* player = game->m_players[PLAYER_PLAYER];
+
+		// Rounds are exported through the worker's own buffer, which only touches the shared file once it's full.
+		auto* exportBuffer = _writer != nullptr ? CreateExportBuffer(_writer) : nullptr;
+		RoundRecord record{};
+		ExportRow row{};
+
+		const auto sessionEnd = _settings->m_firstSession + _settings->m_sessions;
+
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+		GetAllocationsSince(&workerStart, &allocations);
+		MergeAllocationReport(&o_report->m_workerAllocations, &allocations);
+#endif
+
+		auto batchBegin = _nextSession->fetch_add(c_sessionBatchSize);
+		while (batchBegin < sessionEnd)
+		{
+			const auto batchEnd = batchBegin + c_sessionBatchSize < sessionEnd ? batchBegin + c_sessionBatchSize : sessionEnd;
+
+			for (auto session = batchBegin; session < batchEnd; session++)
+			{
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+				GetAllocationReport(&sessionStart);
+				windowStart = sessionStart;
+#endif
+
+				// Each session starts on its own run of orderings, rather than one along from the last, which would deal the same shoes one behind.
+				if (_library != nullptr)
+				{
+					SetShoeLibrary(game, _library, session * GetSessionLibraryShoes(_settings->m_decks, _settings->m_maxRounds));
+				}
+				ResetGame(game, DeriveSeed(_settings->m_seed, (unsigned long long)session));
+				game->m_aceValue = _settings->m_aceValue;
+				player->m_bank = _settings->m_startingBank;
+
+				BetState betState{ 0 };
+				auto peakBank = player->m_bank;
+				auto maxDrawdown = 0;
+
+				// Just like GameLoop, the session ends as soon as the player has less than 1 left, or they choose to stop.
+				auto rounds = 0;
+				while (rounds < _settings->m_maxRounds && player->m_bank >= 1 && player->m_bank > _settings->m_stopLoss &&
+					(_settings->m_stopWin == 0 || player->m_bank < _settings->m_stopWin))
+				{
+					const auto bet = SelectPolicyBet(&_settings->m_betPolicy, &betState, game);
+
+					const auto roundResult = PlaySimulatedRound(game, _settings, bet, _settings->m_collectOutcomes ? &o_report->m_outcomes : nullptr,
+						o_report->m_sideBets, exportBuffer != nullptr ? &record : nullptr);
+					UpdateBetState(&betState, roundResult);
+
+					if (exportBuffer != nullptr)
+					{
+						row.m_values[EXPORT_COLUMN_SESSION] = session;
+						row.m_values[EXPORT_COLUMN_BET] = bet;
+						row.m_values[EXPORT_COLUMN_OUTCOME] = roundResult;
+						row.m_values[EXPORT_COLUMN_PLAYER_TOTAL] = record.m_playerTotal;
+						row.m_values[EXPORT_COLUMN_DEALER_TOTAL] = record.m_dealerTotal;
+						row.m_values[EXPORT_COLUMN_UPCARD] = record.m_upcard;
+						row.m_values[EXPORT_COLUMN_BANK] = player->m_bank;
+						AddExportRow(exportBuffer, &row);
+					}
+
+					// Side bets have their own report, so only the main bet counts towards the round's result.
+					const auto result = (double)(GetPayout(roundResult, bet) - bet) / bet;
+					o_report->m_totalResult += result;
+					o_report->m_totalResultSquared += result * result;
+					rounds++;
+
+					peakBank = player->m_bank > peakBank ? player->m_bank : peakBank;
+					maxDrawdown = peakBank - player->m_bank > maxDrawdown ? peakBank - player->m_bank : maxDrawdown;
+
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+					if (rounds % c_allocationWindowRounds == 0)
+					{
+						GetAllocationsSince(&windowStart, &allocations);
+						o_report->m_allocatingWindows += GetTotalAllocations(&allocations) > 0 ? 1 : 0;
+						o_report->m_windows++;
+						GetAllocationReport(&windowStart);
+					}
+#endif
+				}
+
+				AddSessionToReport(o_report, rounds, player->m_bank, maxDrawdown);
+
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+				GetAllocationsSince(&sessionStart, &allocations);
+				o_report->m_allocatingSessions += GetTotalAllocations(&allocations) > 0 ? 1 : 0;
+				MergeAllocationReport(&o_report->m_sessionAllocations, &allocations);
+#endif
+			}
+
+			batchBegin = _nextSession->fetch_add(c_sessionBatchSize);
+		}
+
+		if (exportBuffer != nullptr)
+		{
+			DestroyExportBuffer(exportBuffer);
+		}
+
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+		GetAllocationReport(&workerStart);
+#endif
+
+		EndGame(game);
+
+#ifdef BLACKJACK_TRACK_ALLOCATIONS
+		GetAllocationsSince(&workerStart, &allocations);
+		MergeAllocationReport(&o_report->m_workerAllocations, &allocations);
+#endif
+	}
+
+	eHandValidityComparison PlaySimulatedRound(Game* _game, const SimulationSettings* _settings, const int _bet, OutcomeTable* o_outcomes, SideBetReport* o_sideBets,
+		RoundRecord* o_record)
+	{
+		auto* player = _game->m_players[PLAYER_PLAYER];
+
+		player->m_bank -= _bet;
+		_game->m_currentBet = _bet;
+
+		// Side bets go down with the main bet, out of whatever the player has left.
+		auto sideBets = false;
+		for (auto sideBet = 0; sideBet < TOTAL_SIDE_BETS; sideBet++)
+		{
+			const auto sideBetAmount = _settings->m_sideBets[sideBet] < player->m_bank ? _settings->m_sideBets[sideBet] : player->m_bank;
+			player->m_bank -= sideBetAmount;
+			_game->m_sideBets[sideBet] = sideBetAmount;
+			sideBets |= sideBetAmount > 0;
+		}
+
+		DealInitialHands(_game);
+
+		if (sideBets)
+		{
+			int sideBetAmounts[TOTAL_SIDE_BETS];
+			for (auto sideBet = 0; sideBet < TOTAL_SIDE_BETS; sideBet++)
+			{
+				sideBetAmounts[sideBet] = _game->m_sideBets[sideBet];
+			}
+
+			eSideBetResult sideBetResults[TOTAL_SIDE_BETS];
+			SettleSideBets(_game, sideBetResults);
+
+			for (auto sideBet = 0; o_sideBets != nullptr && sideBet < TOTAL_SIDE_BETS; sideBet++)
+			{
+				if (sideBetAmounts[sideBet] > 0)
+				{
+					o_sideBets[sideBet].m_results[sideBetResults[sideBet]]++;
+					o_sideBets[sideBet].m_wagered += sideBetAmounts[sideBet];
+					o_sideBets[sideBet].m_returned += GetSideBetPayout(sideBetResults[sideBet], sideBetAmounts[sideBet]);
+				}
+			}
+		}
+
+		// Every decision's hand value is remembered, so it can be put in the outcome table once the round's result is known.
+		// There can't be more decisions than cards in a hand, and the last one is always a stand (or a bust).
+		// Every threshold is 21 or under, so the player stops once they're bust, but the hit loop is bounded by the hand size as well so this can't overflow.
+		int decisionTotals[c_maxHandSize];
+		auto decisions = 0;
+
+		// The strategy is looked up once, so that every decision is only a single read from its table.
+		const auto* strategy = _settings->m_basicStrategy ? GetBasicStrategy(_game->m_aceValue) : nullptr;
+		const auto upcardClass = GetValueClass(_game->m_players[PLAYER_DEALER]->m_hand.m_cards[1].m_rank);
+
+		// The player hits until they reach their threshold. A threshold of 21 or under also stops them once they're bust.
+		// Basic strategy only covers hands that aren't bust, so the player always stops once they are.
+		BEGIN_ALLOCATION_SCOPE(ALLOCATION_SCOPE_PLAYER_TURN);
+
+		auto totalHandValue = GetTotalHandValue(player, _game->m_aceValue);
+		while (player->m_hand.m_size < c_maxHandSize && (strategy != nullptr ?
+			totalHandValue <= 21 && strategy->m_actions[totalHandValue][upcardClass] == PLAYER_ACTION_HIT : totalHandValue < _settings->m_standThreshold))
+		{
+			decisionTotals[decisions++] = totalHandValue;
+
+			DealCard(_game, &player->m_hand);
+			totalHandValue = GetTotalHandValue(player, _game->m_aceValue);
+		}
+
+		const auto stood = totalHandValue <= 21;
+		if (stood)
+		{
+			decisionTotals[decisions++] = totalHandValue;
+		}
+
+		END_ALLOCATION_SCOPE();
+
+		// The face-up card has to be read before the dealer plays, since the hole card is turned over in PlayDealerHand.
+		const auto upcard = GetCardValue(&_game->m_players[PLAYER_DEALER]->m_hand.m_cards[1], _game->m_aceValue);
+
+		PlayDealerHand(_game);
+
+		const auto result = CompareHands(player, _game->m_players[PLAYER_DEALER], _game->m_aceValue);
+		const auto payout = GetPayout(result, _bet);
+		TRACEPOINT_PAYOUT(result, _bet, payout, totalHandValue, GetTotalHandValue(_game->m_players[PLAYER_DEALER], _game->m_aceValue));
+
+		if (o_record != nullptr)
+		{
+			o_record->m_playerTotal = totalHandValue;
+			o_record->m_dealerTotal = GetTotalHandValue(_game->m_players[PLAYER_DEALER], _game->m_aceValue);
+			o_record->m_upcard = upcard;
+		}
+		player->m_bank += payout;
+		_game->m_currentBet = 0;
+
+		if (o_outcomes != nullptr)
+		{
+			const auto netResult = (double)(payout - _bet) / _bet;
+			for (auto decision = 0; decision < decisions; decision++)
+			{
+				// Every decision is a hit, apart from the last one if the player stood.
+				const auto action = stood && decision == decisions - 1 ? PLAYER_ACTION_STAND : PLAYER_ACTION_HIT;
+
+				auto& cell = o_outcomes->m_cells[decisionTotals[decision]][upcard][action];
+				cell.m_results[result]++;
+				cell.m_totalResult += netResult;
+			}
+		}
+
+		DiscardHands(_game);
+
+		return result;
+	}
+
+	bool RunRiskOfRuin(const SimulationSettings* _settings, RuinReport* o_report)
+	{
+		// The library is opened once and shared by every worker. Its deck count has to match the shoe it's dealt into.
+		ShoeLibrary* library = nullptr;
+		if (_settings->m_shoeLibraryPath[0] != '\0')
+		{
+			library = OpenShoeLibrary(_settings->m_shoeLibraryPath);
+			if (library == nullptr || library->m_decks != _settings->m_decks || _settings->m_continuousShuffle)
+			{
+				if (library != nullptr)
+				{
+					CloseShoeLibrary(library);
+				}
+				return false;
+			}
+		}
+
+		ExportWriter* writer = nullptr;
+		if (_settings->m_exportFormat != EXPORT_FORMAT_NONE)
+		{
+			writer = CreateExportWriter(_settings->m_exportPath, _settings->m_exportFormat);
+			if (writer == nullptr)
+			{
+				if (library != nullptr)
+				{
+					CloseShoeLibrary(library);
+				}
+				return false;
+			}
+		}
+
+		auto threadCount = _settings->m_threads > 0 ? _settings->m_threads : (int)std::thread::hardware_concurrency();
+		if (threadCount < 1)
+		{
+			threadCount = 1;
+		}
+
+		ResetRuinReport(o_report, _settings);
+
+		// Every worker fills its own report, so that they never have to share anything other than the session counter.
+		auto* reports = new RuinReport[threadCount];
+		auto* threads = new std::thread[threadCount];
+		std::atomic<long long> nextSession(_settings->m_firstSession);
+
+		// Both engines play every session exactly the same, so the lockstep one is used whenever it can be.
+		const auto lockstep = _settings->m_lockstep && IsLockstepSupported(_settings);
+
+		// Copied sketches would all compact with the same random choices, so their rounding would pile up instead of cancelling out once merged.
+		// Each worker's sketches get their own stream instead, which also depends on the first session so that every shard's workers differ too.
+		const auto sketchSeed = DeriveSeed(_settings->m_seed, (unsigned long long)_settings->m_firstSession);
+
+		for (auto threadIndex = 0; threadIndex < threadCount; threadIndex++)
+		{
+			reports[threadIndex] = *o_report;
+			SeedRuinSketches(&reports[threadIndex], DeriveSeed(sketchSeed, (unsigned long long)threadIndex));
+			if (lockstep)
+			{
+				threads[threadIndex] = std::thread(RunLockstepWorker, _settings, &nextSession, &reports[threadIndex]);
+			}
+			else
+			{
+				threads[threadIndex] = std::thread(RunRuinWorker, _settings, &nextSession, writer, library, &reports[threadIndex]);
+			}
+		}
+
+		for (auto threadIndex = 0; threadIndex < threadCount; threadIndex++)
+		{
+			threads[threadIndex].join();
+		}
+
+		// Every worker has already written out what was left in its buffer, so the file is complete unless a write failed.
+		const auto exported = writer == nullptr || DestroyExportWriter(writer);
+		if (library != nullptr)
+		{
+			CloseShoeLibrary(library);
+		}
+
+		// The reports are merged in pairs, with every pair on its own thread, halving the amount of reports left each time.
+		for (auto stride = 1; stride < threadCount; stride *= 2)
+		{
+			for (auto threadIndex = 0; threadIndex + stride < threadCount; threadIndex += stride * 2)
+			{
+				threads[threadIndex] = std::thread(MergeRuinReport, &reports[threadIndex], &reports[threadIndex + stride]);
+			}
+
+			for (auto threadIndex = 0; threadIndex + stride < threadCount; threadIndex += stride * 2)
+			{
+				threads[threadIndex].join();
+			}
+		}
+
+		*o_report = reports[0];
+
+		delete[] threads;
+		delete[] reports;
+
+		return exported;
+	}
+
+	void AddSessionToReport(RuinReport* o_report, const int _rounds, const int _finalBank, const int _maxDrawdown)
+	{
+		o_report->m_sessions++;
+		o_report->m_rounds += _rounds;
+		o_report->m_totalFinalBank += _finalBank;
+
+		AddToQuantileSketch(&o_report->m_finalBanks, _finalBank);
+		AddToQuantileSketch(&o_report->m_sessionRounds, _rounds);
+		AddToQuantileSketch(&o_report->m_maxDrawdowns, _maxDrawdown);
+
+		if (_finalBank < 1)
+		{
+			o_report->m_ruined++;
+			o_report->m_ruinRounds[GetHistogramBucket(_rounds, o_report->m_maxRounds)]++;
+		}
+	}
+
+	void ResetRuinReport(RuinReport* o_report, const SimulationSettings* _settings)
+	{
+		*o_report = RuinReport{};
+		o_report->m_maxRounds = _settings->m_maxRounds;
+
+		// Sketches don't need to know the range of their values, unlike histograms, so they work just as well for any bank or bet.
+		SeedRuinSketches(o_report, _settings->m_seed);
+	}
+
+	void MergeRuinReport(RuinReport* _report, const RuinReport* _other)
+	{
+		_report->m_sessions += _other->m_sessions;
+		_report->m_ruined += _other->m_ruined;
+		_report->m_rounds += _other->m_rounds;
+		_report->m_totalResult += _other->m_totalResult;
+		_report->m_totalResultSquared += _other->m_totalResultSquared;
+		_report->m_totalFinalBank += _other->m_totalFinalBank;
+
+		for (auto bucket = 0; bucket < c_histogramSize; bucket++)
+		{
+			_report->m_ruinRounds[bucket] += _other->m_ruinRounds[bucket];
+		}
+
+		MergeQuantileSketch(&_report->m_finalBanks, &_other->m_finalBanks);
+		MergeQuantileSketch(&_report->m_sessionRounds, &_other->m_sessionRounds);
+		MergeQuantileSketch(&_report->m_maxDrawdowns, &_other->m_maxDrawdowns);
+
+		for (auto sideBet = 0; sideBet < TOTAL_SIDE_BETS; sideBet++)
+		{
+			for (auto result = 0; result < TOTAL_SIDE_BET_RESULTS; result++)
+			{
+				_report->m_sideBets[sideBet].m_results[result] += _other->m_sideBets[sideBet].m_results[result];
+			}
+
+			_report->m_sideBets[sideBet].m_wagered += _other->m_sideBets[sideBet].m_wagered;
+			_report->m_sideBets[sideBet].m_returned += _other->m_sideBets[sideBet].m_returned;
+		}
+
+		MergeAllocationReport(&_report->m_workerAllocations, &_other->m_workerAllocations);
+		MergeAllocationReport(&_report->m_sessionAllocations, &_other->m_sessionAllocations);
+		_report->m_allocatingSessions += _other->m_allocatingSessions;
+		_report->m_allocatingWindows += _other->m_allocatingWindows;
+		_report->m_windows += _other->m_windows;
+
+		MergeOutcomeTable(&_report->m_outcomes, &_other->m_outcomes);
+	}
+
+	void MergeOutcomeTable(OutcomeTable* _table, const OutcomeTable* _other)
+	{
+		// The table is dense, so it can just be walked as one flat array of cells.
+		auto* cells = &_table->m_cells[0][0][0];
+		const auto* otherCells = &_other->m_cells[0][0][0];
+
+		for (auto cellIndex = 0; cellIndex < c_outcomeTotals * c_outcomeUpcards * TOTAL_PLAYER_ACTIONS; cellIndex++)
+		{
+			for (auto result = 0; result <= HAND_COMPARISON_NATURAL; result++)
+			{
+				cells[cellIndex].m_results[result] += otherCells[cellIndex].m_results[result];
+			}
+
+			cells[cellIndex].m_totalResult += otherCells[cellIndex].m_totalResult;
+		}
+	}
+
+	void RiskOfRuinMenu()
+	{
+		SimulationSettings settings{ 1, false, 11, 17, false, {}, {}, c_startingBank, 1, 0, 0, 0, 1, 0, true, 0, false, EXPORT_FORMAT_NONE, {}, {} };
+
+		system("CLS");
+		std::cout << "How many sessions should be simulated? (In thousands)\n";
+		settings.m_sessions = GetInput(1000000, "a session count", "", " thousand", "") * 1000ll;
+
+		std::cout << "\nHow should each bet be chosen?\nOptions:\n";
+		for (auto policyIndex = 0; policyIndex < TOTAL_BET_POLICIES; policyIndex++)
+		{
+			std::cout << "(" << policyIndex + 1 << ") - " << GetBetPolicyName((eBetPolicy)policyIndex) << "\n";
+		}
+		const auto policyType = (eBetPolicy)(GetOption(TOTAL_BET_POLICIES) - 1);
+
+		std::cout << "\nWhat is the smallest bet? (Starting Money: \x9C" << c_startingBank << ")\n";
+		const auto baseBet = GetBet(c_startingBank);
+
+		// A flat bet never changes, so there's no need to ask for a maximum.
+		auto maxBet = baseBet;
+		if (policyType != BET_POLICY_FLAT)
+		{
+			std::cout << "\nWhat is the largest bet? (Anything below \x9C" << baseBet << " is raised to it)\n";
+			maxBet = GetBet(c_startingBank * 10);
+		}
+
+		settings.m_betPolicy = GetDefaultBetPolicy(policyType, baseBet, maxBet);
+
+		std::cout << "\nHow should each hand be played?\n(1) - Hit until 17, like the dealer\n(2) - Basic strategy\n";
+		settings.m_basicStrategy = GetOption(2) == 2;
+
+		std::cout << "\nShould any side bets be played each round?\n(1) - No\n(2) - " << c_sideBetNames[SIDE_BET_PERFECT_PAIRS] << "\n(3) - " <<
+			c_sideBetNames[SIDE_BET_TWENTY_ONE_PLUS_THREE] << "\n(4) - Both\n";
+		const auto sideBetOption = GetOption(4);
+		if (sideBetOption > 1)
+		{
+			std::cout << "\nHow much should be put on each side bet?\n";
+			const auto sideBetAmount = GetBet(c_startingBank);
+
+			settings.m_sideBets[SIDE_BET_PERFECT_PAIRS] = sideBetOption == 2 || sideBetOption == 4 ? sideBetAmount : 0;
+			settings.m_sideBets[SIDE_BET_TWENTY_ONE_PLUS_THREE] = sideBetOption == 3 || sideBetOption == 4 ? sideBetAmount : 0;
+		}
+
+		std::cout << "\nHow many rounds can a session last before it is stopped?\n";
+		settings.m_maxRounds = GetInput(1000000, "a round limit", "", "", "");
+
+		std::cout << "\nShould the shoes be dealt from recorded orderings?\n(1) - No\n(2) - Yes (" << c_shoeLibraryFileName << ")\n";
+		if (GetOption(2) == 2)
+		{
+			// The library decides how many decks are in the shoe, and a continuous shoe can't follow an ordering, so neither are asked for.
+			auto* library = OpenShoeLibrary(c_shoeLibraryFileName);
+			if (library == nullptr)
+			{
+				std::cout << "Could not open " << c_shoeLibraryFileName << " as a library of shoes!\n\n" << std::flush;
+				system("PAUSE");
+				return;
+			}
+
+			std::cout << "Dealing from " << library->m_shoes << " recorded shoes of " << library->m_decks << " decks.\n";
+
+			// Indices past the end of the library wrap around, so past this many sessions, they start dealing the same shoes as earlier ones.
+			const auto sessionShoes = GetSessionLibraryShoes(library->m_decks, settings.m_maxRounds);
+			std::cout << "Each session starts " << sessionShoes << " shoes after the last, so ";
+			if (settings.m_sessions * sessionShoes <= library->m_shoes)
+			{
+				std::cout << "every session deals its own shoes.\n";
+			}
+			else
+			{
+				std::cout << "only " << library->m_shoes / sessionShoes << " sessions deal their own shoes, and the rest share them!\n";
+			}
+			settings.m_decks = library->m_decks;
+			strcpy_s(settings.m_shoeLibraryPath, c_shoeLibraryFileName);
+			CloseShoeLibrary(library);
+		}
+		else
+		{
+			std::cout << "\nHow many decks should be in the shoe?\n";
+			settings.m_decks = GetInput(c_maxShoeDecks, "a deck count", "", "", "");
+
+			std::cout << "\nHow should the shoe be shuffled?\n(1) - Reshuffle the discard pile once the shoe is empty\n(2) - Continuous shuffling machine\n";
+			settings.m_continuousShuffle = GetOption(2) == 2;
+		}
+
+		std::cout << "\nShould the results of every decision be collected?\n(1) - Yes\n(2) - No\n";
+		settings.m_collectOutcomes = GetOption(2) == 1;
+
+		std::cout << "\nShould every round be exported?\n(1) - No\n(2) - Columnar (" << c_exportFileNames[EXPORT_FORMAT_COLUMNS] <<
+			")\n(3) - CSV (" << c_exportFileNames[EXPORT_FORMAT_CSV] << ")\n";
+		settings.m_exportFormat = (eExportFormat)(GetOption(3) - 1);
+		strcpy_s(settings.m_exportPath, c_exportFileNames[settings.m_exportFormat]);
+
+		std::cout << "\nHow many processes should the simulation be split across? ((1) runs it all in this process)\n";
+		const auto processes = GetInput(c_maxShards, "a process count", "(", ")", "");
+
+		// Just like the game itself, the simulation follows the seed set in main.
+		settings.m_seed = (unsigned long long)rand() << 32 | (unsigned long long)rand();
+
+		std::cout << "\nSimulating...\n" << std::flush;
+
+		const auto start = std::chrono::steady_clock::now();
+
+		// The report is far too big to be kept on the stack.
+		auto* report = new RuinReport{};
+		if (processes > 1)
+		{
+			// Any shards that failed have already been reported. Results missing some of their shards would be misleading, so none are shown.
+			if (!RunShardedRiskOfRuin(&settings, processes, report))
+			{
+				std::cout << "Could not run every shard of the simulation!\n\n" << std::flush;
+				delete report;
+				system("PAUSE");
+				return;
+			}
+		}
+		else if (!RunRiskOfRuin(&settings, report))
+		{
+			// The library was already opened once above, so it's almost always the export file that failed.
+			if (settings.m_exportFormat != EXPORT_FORMAT_NONE)
+			{
+				std::cout << "Could not open or finish writing " << settings.m_exportPath << " for exporting!\n\n" << std::flush;
+			}
+			else
+			{
+				std::cout << "Could not open " << settings.m_shoeLibraryPath << " to deal from!\n\n" << std::flush;
+			}
+			delete report;
+			system("PAUSE");
+			return;
+		}
+
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		system("CLS");
+		DisplayRuinReport(report);
+		if (settings.m_collectOutcomes)
+		{
+			DisplayOutcomeTable(&report->m_outcomes);
+		}
+
+		std::cout << "Simulated in " << std::fixed << std::setprecision(2) << elapsed.count() << " seconds (" <<
+			std::setprecision(0) << (double)report->m_rounds / elapsed.count() << " rounds per second).\n\n" << std::flush;
+
+		delete report;
+		system("PAUSE");
+	}
+
+	void DisplayRuinReport(const RuinReport* _report)
+	{
+		// The expected value and variance of a single round, measured in bets.
+		const auto rounds = _report->m_rounds > 0 ? (double)_report->m_rounds : 1.0;
+		const auto mean = _report->m_totalResult / rounds;
+		const auto variance = _report->m_totalResultSquared / rounds - mean * mean;
+
+		std::cout << std::fixed << std::setprecision(2);
+		std::cout << "Sessions: " << _report->m_sessions << " Rounds: " << _report->m_rounds << "\n\n";
+
+		std::cout << "Risk of Ruin: " << 100.0 * (double)_report->m_ruined / (double)(_report->m_sessions > 0 ? _report->m_sessions : 1) << "%\n";
+		std::cout << "Expected Value: " << 100.0 * mean << "% of each bet, Standard Deviation: " << std::sqrt(variance) << " bets\n";
+
+		// N0 is the amount of rounds it takes for the expected value to equal one standard deviation.
+		if (mean != 0.0)
+		{
+			std::cout << "N0: " << std::setprecision(0) << variance / (mean * mean) << " rounds\n\n";
+		}
+		else
+		{
+			std::cout << "N0: Infinite\n\n";
+		}
+
+		std::cout << std::setprecision(0);
+		if (_report->m_ruined > 0)
+		{
+			std::cout << "Rounds Until Ruin:" <<
+				" 10%: " << GetHistogramQuantile(_report->m_ruinRounds, 0.1, _report->m_maxRounds) <<
+				" 50%: " << GetHistogramQuantile(_report->m_ruinRounds, 0.5, _report->m_maxRounds) <<
+				" 90%: " << GetHistogramQuantile(_report->m_ruinRounds, 0.9, _report->m_maxRounds) << "\n";
+		}
+
+		std::cout << "Final Bank:" <<
+			" 1%: \x9C" << GetSketchQuantile(&_report->m_finalBanks, 0.01) <<
+			" 10%: \x9C" << GetSketchQuantile(&_report->m_finalBanks, 0.1) <<
+			" 50%: \x9C" << GetSketchQuantile(&_report->m_finalBanks, 0.5) <<
+			" 90%: \x9C" << GetSketchQuantile(&_report->m_finalBanks, 0.9) <<
+			" 99%: \x9C" << GetSketchQuantile(&_report->m_finalBanks, 0.99) << "\n";
+
+		std::cout << "Session Length:" <<
+			" 1%: " << GetSketchQuantile(&_report->m_sessionRounds, 0.01) <<
+			" 10%: " << GetSketchQuantile(&_report->m_sessionRounds, 0.1) <<
+			" 50%: " << GetSketchQuantile(&_report->m_sessionRounds, 0.5) <<
+			" 90%: " << GetSketchQuantile(&_report->m_sessionRounds, 0.9) <<
+			" 99%: " << GetSketchQuantile(&_report->m_sessionRounds, 0.99) << " rounds\n";
+
+		std::cout << "Max Drawdown:" <<
+			" 50%: \x9C" << GetSketchQuantile(&_report->m_maxDrawdowns, 0.5) <<
+			" 90%: \x9C" << GetSketchQuantile(&_report->m_maxDrawdowns, 0.9) <<
+			" 99%: \x9C" << GetSketchQuantile(&_report->m_maxDrawdowns, 0.99) <<
+			" Max: \x9C" << GetSketchQuantile(&_report->m_maxDrawdowns, 1.0) << "\n\n";
+
+		for (auto sideBet = 0; sideBet < TOTAL_SIDE_BETS; sideBet++)
+		{
+			const auto* sideBetReport = &_report->m_sideBets[sideBet];
+			if (sideBetReport->m_wagered == 0)
+			{
+				continue;
+			}
+
+			long long played = 0;
+			for (auto result = 0; result < TOTAL_SIDE_BET_RESULTS; result++)
+			{
+				played += sideBetReport->m_results[result];
+			}
+
+			std::cout << std::setprecision(2) << c_sideBetNames[sideBet] << " House Edge: " <<
+				100.0 * (double)(sideBetReport->m_wagered - sideBetReport->m_returned) / (double)sideBetReport->m_wagered << "%\n";
+
+			// Each side bet only ever gives some of the results, so the ones that never came up are left out.
+			for (auto result = SIDE_BET_RESULT_NONE + 1; result < TOTAL_SIDE_BET_RESULTS; result++)
+			{
+				if (sideBetReport->m_results[result] > 0)
+				{
+					std::cout << " " << c_sideBetResultNames[result] << " (" << c_sideBetOdds[result] << " to 1): " <<
+						100.0 * (double)sideBetReport->m_results[result] / (double)played << "%";
+				}
+			}
+			std::cout << "\n\n";
+		}
+
+		if (c_trackAllocations)
+		{
+			std::cout << "Allocating Sessions: " << _report->m_allocatingSessions << " of " << _report->m_sessions <<
+				", Allocating Windows: " << _report->m_allocatingWindows << " of " << _report->m_windows << "\n";
+
+			std::cout << "Worker Allocations:\n";
+			DisplayAllocationReport(std::cout, &_report->m_workerAllocations);
+			std::cout << "Session Allocations:\n";
+			DisplayAllocationReport(std::cout, &_report->m_sessionAllocations);
+			std::cout << "\n";
+		}
+	}
+
+	void DisplayOutcomeTable(const OutcomeTable* _table)
+	{
+		// Situations with fewer rounds than this are left blank, since their EV would mostly just be noise.
+		constexpr auto minimumRounds = 100;
+
+		for (auto action = 0; action < TOTAL_PLAYER_ACTIONS; action++)
+		{
+			std::cout << (action == PLAYER_ACTION_HIT ? "Hit" : "Stand") << " EV (% of bet) by Hand Value (rows) and Dealer Card (columns)\n";
+
+			std::cout << std::setw(6) << "";
+			for (auto upcard = 1; upcard < c_outcomeUpcards; upcard++)
+			{
+				std::cout << std::setw(7) << std::right << upcard;
+			}
+			std::cout << "\n";
+
+			std::cout << std::setprecision(1);
+			for (auto total = 4; total < c_outcomeTotals; total++)
+			{
+				std::cout << std::setw(6) << std::right << total;
+				for (auto upcard = 1; upcard < c_outcomeUpcards; upcard++)
+				{
+					const auto& cell = _table->m_cells[total][upcard][action];
+
+					long long rounds = 0;
+					for (auto result = 0; result <= HAND_COMPARISON_NATURAL; result++)
+					{
+						rounds += cell.m_results[result];
+					}
+
+					if (rounds < minimumRounds)
+					{
+						std::cout << std::setw(7) << "";
+					}
+					else
+					{
+						std::cout << std::setw(7) << 100.0 * cell.m_totalResult / (double)rounds;
+					}
+				}
+				std::cout << "\n";
+			}
+
+			// The columns were right-aligned, so put the stream back the way the rest of the program expects it.
+			std::cout << std::left << "\n";
+		}
+	}
+}
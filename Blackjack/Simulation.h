@@ -0,0 +1,330 @@
+#pragma once
+
+#ifndef SIMULATION_H_
+#define SIMULATION_H_
+
+#include "AllocationTracker.h"
+#include "BetPolicy.h"
+#include "Export.h"
+#include "Game.h"
+#include "Sketch.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The amount of buckets used for each distribution in a report. More buckets means more accurate quantiles.
+	/// </summary>
+	constexpr auto c_histogramSize = 1024;
+
+	/// <summary>
+	/// The amount of sessions a worker thread claims at once. Big enough that threads rarely touch the shared counter.
+	/// </summary>
+	constexpr auto c_sessionBatchSize = 256;
+
+	/// <summary>
+	/// The longest path an export file can have, including the zero-terminator.
+	/// </summary>
+	constexpr auto c_maxExportPathSize = 260;
+
+	/// <summary>
+	/// Outcome tables have one row for every hand value the player can make a decision on, from 0 to 21.
+	/// </summary>
+	constexpr auto c_outcomeTotals = 22;
+
+	/// <summary>
+	/// Outcome tables have one column for every value the dealer's face-up card can have, from 0 to 11.
+	/// </summary>
+	constexpr auto c_outcomeUpcards = 12;
+
+	/// <summary>
+	/// The results of every round where the player made one specific decision, in one specific situation.
+	/// </summary>
+	struct OutcomeCell
+	{
+		/// <summary>
+		/// How many of the rounds ended in each result, indexed by eHandValidityComparison.
+		/// </summary>
+		long long m_results[HAND_COMPARISON_NATURAL + 1];
+
+		/// <summary>
+		/// The sum of every round's net result, measured in bets. Divided by the total rounds, this is the decision's EV.
+		/// </summary>
+		double m_totalResult;
+	};
+
+	/// <summary>
+	/// A dense table of outcomes, indexed by the player's hand value, the dealer's face-up card value, and the decision made.<br>
+	/// A round where the player makes several decisions counts towards the cell of every one of them.
+	/// </summary>
+	struct OutcomeTable
+	{
+		OutcomeCell m_cells[c_outcomeTotals][c_outcomeUpcards][TOTAL_PLAYER_ACTIONS];
+	};
+
+	/// <summary>
+	/// Everything needed to describe a headless simulation. The player follows either a simple dealer-style strategy, or basic strategy.
+	/// </summary>
+	struct SimulationSettings
+	{
+		/// <summary>
+		/// The amount of full decks in the shoe.
+		/// </summary>
+		int m_decks;
+
+		/// <summary>
+		/// Whether the shoe is a continuous shuffling machine, which takes every card back after each round.
+		/// </summary>
+		bool m_continuousShuffle;
+
+		/// <summary>
+		/// The integer value of Aces (should be 1 or 11). Unlike the interactive game, this is fixed for every round.
+		/// </summary>
+		int m_aceValue;
+
+		/// <summary>
+		/// The player hits until their hand is valued at least this much, unless they're following basic strategy.
+		/// </summary>
+		int m_standThreshold;
+
+		/// <summary>
+		/// Whether the player follows the built-in basic strategy for the ace value, instead of the stand threshold.
+		/// </summary>
+		bool m_basicStrategy;
+
+		/// <summary>
+		/// How the player chooses each bet. If the player has less than the policy wants, they bet everything they have left.
+		/// </summary>
+		BetPolicy m_betPolicy;
+
+		/// <summary>
+		/// How much is put on each side bet every round, alongside the main bet. 0 means the side bet isn't played.<br>
+		/// If the player can't afford a side bet once their main bet is down, they put whatever they have left on it.
+		/// </summary>
+		int m_sideBets[TOTAL_SIDE_BETS];
+
+		int m_startingBank;
+
+		/// <summary>
+		/// A session that hasn't gone bankrupt after this many rounds is stopped, and counted as a survivor.
+		/// </summary>
+		int m_maxRounds;
+
+		/// <summary>
+		/// The player stops playing, just like choosing (2) at the end of a round, once their bank reaches "m_stopWin" or falls to "m_stopLoss".<br>
+		/// 0 means the player never stops for that reason. Sessions that stop this way aren't counted as ruined.
+		/// </summary>
+		int m_stopWin;
+		int m_stopLoss;
+
+		/// <summary>
+		/// The index of the first session to run, and how many to run from there.<br>
+		/// Sessions are seeded by their index, so splitting one range into many smaller ones gives exactly the same sessions.
+		/// </summary>
+		long long m_firstSession;
+		long long m_sessions;
+
+		/// <summary>
+		/// The amount of worker threads. 0 uses one per hardware thread.
+		/// </summary>
+		int m_threads;
+
+		/// <summary>
+		/// Whether sessions are played many tables at a time, one per vector lane, whenever the settings and the CPU allow it.<br>
+		/// Every session plays out exactly the same either way.
+		/// </summary>
+		bool m_lockstep;
+
+		/// <summary>
+		/// Each session is seeded from this and its own index, so results don't depend on the amount of threads.
+		/// </summary>
+		unsigned long long m_seed;
+
+		/// <summary>
+		/// Whether to fill the report's outcome table. Costs a little speed, so it's off unless it's needed.
+		/// </summary>
+		bool m_collectOutcomes;
+
+		/// <summary>
+		/// How every round is exported, if at all, and the file to export it to.<br>
+		/// The path is stored in the settings themselves rather than pointed to, so the settings can be shared between processes.
+		/// </summary>
+		eExportFormat m_exportFormat;
+		char m_exportPath[c_maxExportPathSize];
+
+		/// <summary>
+		/// A library of recorded shoes to deal from instead of shuffling, or an empty string to shuffle as normal.<br>
+		/// Session "i" starts from ordering "i * GetSessionLibraryShoes", so sessions don't deal each other's shoes, and every session plays
+		/// the same shoes no matter how the sessions are split up. Past the end of the library, sessions wrap around and share shoes.
+		/// </summary>
+		char m_shoeLibraryPath[c_maxExportPathSize];
+	};
+
+	/// <summary>
+	/// Extra details about how a round went, beyond its result.
+	/// </summary>
+	struct RoundRecord
+	{
+		int m_playerTotal;
+		int m_dealerTotal;
+
+		/// <summary>
+		/// The value of the dealer's face-up card.
+		/// </summary>
+		int m_upcard;
+	};
+
+	/// <summary>
+	/// The results of every round one side bet was played in.
+	/// </summary>
+	struct SideBetReport
+	{
+		/// <summary>
+		/// How many rounds ended in each result, indexed by eSideBetResult. SIDE_BET_RESULT_NONE counts every round it lost.
+		/// </summary>
+		long long m_results[TOTAL_SIDE_BET_RESULTS];
+
+		/// <summary>
+		/// The total amount of money put on the side bet, and paid back by it. The difference between them is the house's.
+		/// </summary>
+		long long m_wagered;
+		long long m_returned;
+	};
+
+	/// <summary>
+	/// The combined results of every session in a risk of ruin simulation.<br>
+	/// Distributions are kept as fixed-size histograms and sketches, so a report is the same size no matter how many sessions are run.
+	/// </summary>
+	struct RuinReport
+	{
+		long long m_sessions;
+
+		/// <summary>
+		/// The amount of sessions that ended in bankruptcy, as defined by GameLoop.
+		/// </summary>
+		long long m_ruined;
+
+		long long m_rounds;
+
+		/// <summary>
+		/// The sum of every round's net result and its square, measured in bets. Used for the expected value, variance, and N0.
+		/// </summary>
+		double m_totalResult;
+		double m_totalResultSquared;
+
+		/// <summary>
+		/// How many rounds each ruined session lasted. Bucket "i" covers "i * m_maxRounds / c_histogramSize" rounds onwards.
+		/// </summary>
+		long long m_ruinRounds[c_histogramSize];
+
+		/// <summary>
+		/// Every session's bank when it ended, how many rounds it lasted, and the most it fell from its highest bank along the way.
+		/// </summary>
+		QuantileSketch m_finalBanks;
+		QuantileSketch m_sessionRounds;
+		QuantileSketch m_maxDrawdowns;
+
+		/// <summary>
+		/// The sum of every session's bank when it ended. Divided by the sessions, this is the expected final bank.
+		/// </summary>
+		long long m_totalFinalBank;
+
+		int m_maxRounds;
+
+		/// <summary>
+		/// Indexed by eSideBet. Only filled for the side bets the simulation's settings played.
+		/// </summary>
+		SideBetReport m_sideBets[TOTAL_SIDE_BETS];
+
+		/// <summary>
+		/// Everything allocated while setting up and tearing down each worker's game, and everything allocated while playing sessions.<br>
+		/// A session should never allocate anything, so any counts in the second report point to something on the hot path that needs fixing.<br>
+		/// Only filled when built with BLACKJACK_TRACK_ALLOCATIONS.
+		/// </summary>
+		AllocationReport m_workerAllocations;
+		AllocationReport m_sessionAllocations;
+
+		/// <summary>
+		/// The amount of sessions, and windows of c_allocationWindowRounds rounds, that allocated anything at all, and the amount of windows in total.<br>
+		/// Only filled when built with BLACKJACK_TRACK_ALLOCATIONS.
+		/// </summary>
+		long long m_allocatingSessions;
+		long long m_allocatingWindows;
+		long long m_windows;
+
+		/// <summary>
+		/// Only filled if the simulation's settings asked for it.
+		/// </summary>
+		OutcomeTable m_outcomes;
+	};
+
+	/// <summary>
+	/// Play one full round without any input or output, using the same rules as GameLoop.
+	/// </summary>
+	/// <param name="_game">The game instance. Its ace value must already be set.</param>
+	/// <param name="_settings">The settings to play the round with.</param>
+	/// <param name="_bet">The amount of money to bet. MUST be from 1 to the player's bank, i.e. from SelectPolicyBet.</param>
+	/// <param name="o_outcomes">A table to add the round's decisions and result to, or nullptr to skip it.</param>
+	/// <param name="o_sideBets">The reports to add the round's side bets to, indexed by eSideBet, or nullptr to skip them.</param>
+	/// <param name="o_record">A record to be output into, or nullptr to skip it.</param>
+	/// <returns>The player's hand compared to the dealer's. Side bets are paid out separately, and don't change this.</returns>
+	eHandValidityComparison PlaySimulatedRound(Game* _game, const SimulationSettings* _settings, int _bet, OutcomeTable* o_outcomes, SideBetReport* o_sideBets,
+		RoundRecord* o_record);
+
+	/// <summary>
+	/// Run many independent sessions in parallel, each ending in bankruptcy or after "m_maxRounds" rounds.
+	/// </summary>
+	/// <param name="_settings">The settings to run the simulation with.</param>
+	/// <param name="o_report">The report to be output into. Anything already in it is overwritten.</param>
+	/// <returns>False if the export file couldn't be opened, in which case the simulation isn't run at all,
+	/// or if any of it couldn't be written, in which case the report is filled but the file is incomplete.</returns>
+	bool RunRiskOfRuin(const SimulationSettings* _settings, RuinReport* o_report);
+
+	/// <summary>
+	/// Add a finished session's length, final bank, and drawdown to a report. Each round's result is added to the report as it's played.
+	/// </summary>
+	/// <param name="o_report">The report to be added onto.</param>
+	/// <param name="_rounds">The amount of rounds the session lasted.</param>
+	/// <param name="_finalBank">The player's bank when the session ended. Anything under 1 is counted as ruined.</param>
+	/// <param name="_maxDrawdown">The most the player's bank fell below the highest it had been in the session.</param>
+	void AddSessionToReport(RuinReport* o_report, int _rounds, int _finalBank, int _maxDrawdown);
+
+	/// <summary>
+	/// Empty a report, and set up its histograms and sketches to fit the results of a simulation.
+	/// </summary>
+	/// <param name="o_report">The report to be emptied.</param>
+	/// <param name="_settings">The settings the report will be filled with.</param>
+	void ResetRuinReport(RuinReport* o_report, const SimulationSettings* _settings);
+
+	/// <summary>
+	/// Add every result from one outcome table onto another.
+	/// </summary>
+	/// <param name="_table">The table to be added onto.</param>
+	/// <param name="_other">The table to add.</param>
+	void MergeOutcomeTable(OutcomeTable* _table, const OutcomeTable* _other);
+
+	/// <summary>
+	/// Add every result from one report onto another. Both reports MUST have been made with the same settings.
+	/// </summary>
+	/// <param name="_report">The report to be added onto.</param>
+	/// <param name="_other">The report to add.</param>
+	void MergeRuinReport(RuinReport* _report, const RuinReport* _other);
+
+	/// <summary>
+	/// Ask the user for the settings of a risk of ruin simulation, run it, and display the results.
+	/// </summary>
+	void RiskOfRuinMenu();
+
+	/// <summary>
+	/// Display the risk of ruin, time to ruin, N0, the quantiles of each session's final bank, length, and drawdown, and the house edge of any side bets.
+	/// </summary>
+	/// <param name="_report">The report to display.</param>
+	void DisplayRuinReport(const RuinReport* _report);
+
+	/// <summary>
+	/// Display the EV of hitting and standing in every situation that came up often enough to be meaningful.
+	/// </summary>
+	/// <param name="_table">The table to display.</param>
+	void DisplayOutcomeTable(const OutcomeTable* _table);
+}
+
+#endif
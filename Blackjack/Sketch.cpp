@@ -0,0 +1,130 @@
+#include "Sketch.h"
+
+#include <algorithm>
+#include <climits>
+#include <utility>
+#include <vector>
+
+namespace blackjack
+{
+	/// <summary>
+	/// Add a value to one level of a sketch, compacting that level into the next one up if it's full.<br>
+	/// A value at level "i" stands for 2 to the power of "i" values, so this doesn't change the sketch's count.
+	/// </summary>
+	static void AddToLevel(QuantileSketch* _sketch, const int _level, const int _value)
+	{
+		auto* values = _sketch->m_levels[_level];
+		values[_sketch->m_sizes[_level]++] = _value;
+
+		if (_sketch->m_sizes[_level] < c_sketchCapacity)
+		{
+			return;
+		}
+
+		// Sorting and keeping every other value means each kept value stands in for itself and its neighbour.
+		// Which half is kept is chosen at random, so the neighbours it's rounded towards aren't always the bigger or smaller ones.
+		std::sort(values, values + c_sketchCapacity);
+		const auto offset = (int)(NextRandom(&_sketch->m_random) & 1);
+		_sketch->m_sizes[_level] = 0;
+
+		// The top level would need more values than any simulation can play, but if it's ever reached, it just thins itself out.
+		if (_level == c_sketchLevels - 1)
+		{
+			for (auto index = offset; index < c_sketchCapacity; index += 2)
+			{
+				values[_sketch->m_sizes[_level]++] = values[index];
+			}
+			return;
+		}
+
+		// Nothing above this level ever touches this level's values, so they're safe to read while the levels above compact.
+		for (auto index = offset; index < c_sketchCapacity; index += 2)
+		{
+			AddToLevel(_sketch, _level + 1, values[index]);
+		}
+	}
+
+	void ResetQuantileSketch(QuantileSketch* o_sketch, const unsigned long long _seed)
+	{
+		o_sketch->m_count = 0;
+		o_sketch->m_min = INT_MAX;
+		o_sketch->m_max = INT_MIN;
+		SeedRandom(&o_sketch->m_random, _seed);
+
+		for (auto level = 0; level < c_sketchLevels; level++)
+		{
+			o_sketch->m_sizes[level] = 0;
+		}
+	}
+
+	void AddToQuantileSketch(QuantileSketch* _sketch, const int _value)
+	{
+		_sketch->m_count++;
+		_sketch->m_min = _value < _sketch->m_min ? _value : _sketch->m_min;
+		_sketch->m_max = _value > _sketch->m_max ? _value : _sketch->m_max;
+
+		AddToLevel(_sketch, 0, _value);
+	}
+
+	void MergeQuantileSketch(QuantileSketch* _sketch, const QuantileSketch* _other)
+	{
+		_sketch->m_count += _other->m_count;
+		_sketch->m_min = _other->m_min < _sketch->m_min ? _other->m_min : _sketch->m_min;
+		_sketch->m_max = _other->m_max > _sketch->m_max ? _other->m_max : _sketch->m_max;
+
+		// Every value keeps its level, so it still stands for the same amount of values once it's been merged.
+		for (auto level = 0; level < c_sketchLevels; level++)
+		{
+			for (auto index = 0; index < _other->m_sizes[level]; index++)
+			{
+				AddToLevel(_sketch, level, _other->m_levels[level][index]);
+			}
+		}
+	}
+
+	int GetSketchQuantile(const QuantileSketch* _sketch, const double _quantile)
+	{
+		if (_sketch->m_count < 1)
+		{
+			return 0;
+		}
+
+		if (_quantile <= 0.0)
+		{
+			return _sketch->m_min;
+		}
+
+		if (_quantile >= 1.0)
+		{
+			return _sketch->m_max;
+		}
+
+		// Every value the sketch kept, with the amount of values it stands for.
+		std::vector<std::pair<int, long long>> values;
+		long long total = 0;
+		for (auto level = 0; level < c_sketchLevels; level++)
+		{
+			for (auto index = 0; index < _sketch->m_sizes[level]; index++)
+			{
+				values.emplace_back(_sketch->m_levels[level][index], 1ll << level);
+				total += 1ll << level;
+			}
+		}
+
+		std::sort(values.begin(), values.end());
+
+		const auto target = (long long)(_quantile * (double)total);
+
+		long long seen = 0;
+		for (const auto& value : values)
+		{
+			seen += value.second;
+			if (seen > target)
+			{
+				return value.first;
+			}
+		}
+
+		return _sketch->m_max;
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#ifndef SKETCH_H_
+#define SKETCH_H_
+
+#include "Random.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The amount of values each level of a sketch holds before it's compacted into the next level up.<br>
+	/// Every level holds the same amount, so every compaction adds its own rounding. Out of "n" values, a quantile is only guaranteed to be
+	/// within about log2(n / c_sketchCapacity) / c_sketchCapacity of the total, which is about 10% for a million values.<br>
+	/// Compactions round up or down at random, so most of that cancels out. In practice quantiles are within 1-2% at any amount of values.
+	/// </summary>
+	constexpr auto c_sketchCapacity = 128;
+
+	/// <summary>
+	/// The amount of levels in a sketch. Each level's values stand for twice as many as the level below, so this is plenty for any simulation.
+	/// </summary>
+	constexpr auto c_sketchLevels = 32;
+
+	/// <summary>
+	/// A streaming quantile sketch, which estimates the quantiles of any amount of values in a fixed amount of memory.<br>
+	/// Once a level fills up, it's sorted and every other value is moved up a level, where it stands for two values.<br>
+	/// This is KLL's compactor, but every level keeps the same capacity instead of the lower levels shrinking.<br>
+	/// This is plain data, so sketches can be copied, kept in reports, and shared between processes just like histograms.
+	/// </summary>
+	struct QuantileSketch
+	{
+		/// <summary>
+		/// The total amount of values added to the sketch, including every value it has since thrown away.
+		/// </summary>
+		long long m_count;
+
+		/// <summary>
+		/// The smallest and largest values ever added. These are exact, unlike every other quantile.
+		/// </summary>
+		int m_min;
+		int m_max;
+
+		/// <summary>
+		/// Decides whether the odd or even values are kept at each compaction, so the errors cancel out instead of piling up.
+		/// </summary>
+		Random m_random;
+
+		int m_sizes[c_sketchLevels];
+		int m_levels[c_sketchLevels][c_sketchCapacity];
+	};
+
+	/// <summary>
+	/// Empty a sketch. Every sketch MUST be reset before anything is added to it.
+	/// </summary>
+	/// <param name="o_sketch">The sketch to be emptied.</param>
+	/// <param name="_seed">Seeds the sketch's compactions. The same values added in the same order always give the same sketch.</param>
+	void ResetQuantileSketch(QuantileSketch* o_sketch, unsigned long long _seed);
+
+	/// <summary>
+	/// Add a value to a sketch.
+	/// </summary>
+	/// <param name="_sketch">The sketch to be added onto.</param>
+	/// <param name="_value">The value to add.</param>
+	void AddToQuantileSketch(QuantileSketch* _sketch, int _value);
+
+	/// <summary>
+	/// Add every value from one sketch onto another. The result is as accurate as if every value had been added to one sketch.
+	/// </summary>
+	/// <param name="_sketch">The sketch to be added onto.</param>
+	/// <param name="_other">The sketch to add.</param>
+	void MergeQuantileSketch(QuantileSketch* _sketch, const QuantileSketch* _other);
+
+	/// <summary>
+	/// Estimate a quantile of every value added to a sketch.
+	/// </summary>
+	/// <param name="_sketch">The sketch to read.</param>
+	/// <param name="_quantile">The quantile to find, from 0 to 1. 0 and 1 give the exact minimum and maximum.</param>
+	/// <returns>The estimated value, which is always one of the values that were added. 0 if the sketch is empty.</returns>
+	int GetSketchQuantile(const QuantileSketch* _sketch, double _quantile);
+}
+
+#endif
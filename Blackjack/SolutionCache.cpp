@@ -0,0 +1,191 @@
+#include "SolutionCache.h"
+
+#include <cstring>
+#include <windows.h>
+
+namespace blackjack
+{
+	/// <summary>
+	/// "BJSC", written backwards so that it reads forwards in the file.
+	/// </summary>
+	constexpr long c_solutionCacheMagic = 0x43534A42;
+
+	constexpr long c_entryEmpty = 0;
+	constexpr long c_entryReady = 2;
+
+	/// <summary>
+	/// Whether a slot's claim was left behind by a writer that never finished. Claims from before the machine restarted look like they're
+	/// from the future, since GetTickCount64 starts again from 0, so those are abandoned too.
+	/// </summary>
+	static bool IsClaimAbandoned(const long long _claimed, const long long _now)
+	{
+		return _claimed > _now || _now - _claimed > c_solutionCacheClaimTimeout;
+	}
+
+	/// <summary>
+	/// The canonical key of a composition under a rule set. Equal compositions always have equal keys, in every process.
+	/// </summary>
+	static unsigned long long GetSolutionKey(const Composition* _composition, const int _aceValue)
+	{
+		// FNV-1a, over every count and then the rules.
+		auto key = 14695981039346656037ULL;
+		for (auto valueClass = 0; valueClass < c_valueClasses; valueClass++)
+		{
+			key = (key ^ _composition->m_counts[valueClass]) * 1099511628211ULL;
+		}
+		key = (key ^ (unsigned long long)_aceValue) * 1099511628211ULL;
+		key = (key ^ (unsigned long long)c_dealerStandValue) * 1099511628211ULL;
+
+		return key;
+	}
+
+	/// <summary>
+	/// Whether a ready slot holds the solution for a composition. Keys can collide, so the composition itself is checked too.
+	/// </summary>
+	static bool IsMatchingEntry(const SolutionCacheEntry* _entry, const unsigned long long _key, const Composition* _composition, const int _aceValue)
+	{
+		return _entry->m_key == _key && _entry->m_aceValue == _aceValue &&
+			memcmp(&_entry->m_composition, _composition, sizeof(Composition)) == 0;
+	}
+
+	SolutionCache* OpenSolutionCache(const char _path[], const bool _writable)
+	{
+		const auto size = (long long)sizeof(SolutionCacheHeader) + (long long)sizeof(SolutionCacheEntry) * c_solutionCacheCapacity;
+
+		auto* file = OpenMappedFile(_path, size, _writable);
+		if (file == nullptr)
+		{
+			return nullptr;
+		}
+
+		auto* header = (SolutionCacheHeader*)file->m_view;
+		if (file->m_size < size)
+		{
+			CloseMappedFile(file);
+			return nullptr;
+		}
+
+		// A brand new file is all zeroes. Two writers creating it at once both write the same header, so it doesn't matter who wins.
+		if (header->m_magic == 0 && _writable)
+		{
+			header->m_version = c_solutionCacheVersion;
+			header->m_capacity = c_solutionCacheCapacity;
+			header->m_dealerStandValue = c_dealerStandValue;
+			MemoryBarrier();
+			header->m_magic = c_solutionCacheMagic;
+		}
+
+		if (header->m_magic != c_solutionCacheMagic || header->m_version != c_solutionCacheVersion ||
+			header->m_capacity != c_solutionCacheCapacity || header->m_dealerStandValue != c_dealerStandValue)
+		{
+			CloseMappedFile(file);
+			return nullptr;
+		}
+
+		auto* entries = (SolutionCacheEntry*)(file->m_view + sizeof(SolutionCacheHeader));
+		return new SolutionCache{ file, entries, 0, 0 };
+	}
+
+	void CloseSolutionCache(SolutionCache*& _cache)
+	{
+		CloseMappedFile(_cache->m_file);
+
+		delete _cache;
+		_cache = nullptr;
+	}
+
+	void GetSolution(SolutionCache* _cache, const Composition* _composition, const int _aceValue, CompositionSolution* o_solution)
+	{
+		if (_cache == nullptr)
+		{
+			SolveComposition(_composition, _aceValue, o_solution);
+			return;
+		}
+
+		const auto key = GetSolutionKey(_composition, _aceValue);
+		const auto now = (long long)GetTickCount64();
+
+		// Slots are only ever filled or overwritten, never emptied, so the first empty slot along the probe means the composition isn't cached.
+		// A slot that's still being written by someone else is skipped. It's quicker to solve again than to wait for them.
+		// If there's no empty slot, an abandoned one is overwritten first, and then the oldest ready one along the probe.
+		SolutionCacheEntry* freeEntry = nullptr;
+		long long freeClaimed = 0;
+		for (auto probe = 0; probe < c_solutionCacheProbes; probe++)
+		{
+			auto* entry = &_cache->m_entries[(key + probe) % c_solutionCacheCapacity];
+
+			const auto generation = entry->m_generation;
+			MemoryBarrier();
+			const auto state = entry->m_state;
+			const auto claimed = entry->m_claimed;
+
+			if (claimed != 0 && !IsClaimAbandoned(claimed, now))
+			{
+				if (state == c_entryEmpty)
+				{
+					break;
+				}
+				continue;
+			}
+
+			if (state == c_entryEmpty)
+			{
+				freeEntry = entry;
+				freeClaimed = claimed;
+				break;
+			}
+
+			if (claimed == 0 && (generation & 1) == 0 && IsMatchingEntry(entry, key, _composition, _aceValue))
+			{
+				// The generation is read before the solution, so the solution can't be seen before it was finished.
+				// If the slot was written again while it was being copied, the copy can't be trusted, and the composition is solved instead.
+				MemoryBarrier();
+				*o_solution = entry->m_solution;
+				MemoryBarrier();
+				if (entry->m_generation == generation)
+				{
+					_cache->m_hits++;
+					return;
+				}
+				continue;
+			}
+
+			// An abandoned slot is always the first choice, since whatever is in it can't be trusted anyway.
+			if (freeEntry == nullptr || (freeClaimed == 0 && (claimed != 0 || entry->m_stamp < freeEntry->m_stamp)))
+			{
+				freeEntry = entry;
+				freeClaimed = claimed;
+			}
+		}
+
+		SolveComposition(_composition, _aceValue, o_solution);
+		_cache->m_misses++;
+
+		// Another process could claim the same slot at the same time, so only whoever swaps their time in first gets to write to it.
+		if (freeEntry == nullptr || !_cache->m_file->m_writable ||
+			InterlockedCompareExchange64(&freeEntry->m_claimed, now > 0 ? now : 1, freeClaimed) != freeClaimed)
+		{
+			return;
+		}
+
+		// The generation goes odd before anything is overwritten, so anyone part way through reading the old solution knows to throw it away.
+		// A writer that died part way through has already left it odd.
+		if ((freeEntry->m_generation & 1) == 0)
+		{
+			InterlockedIncrement(&freeEntry->m_generation);
+		}
+
+		auto* header = (SolutionCacheHeader*)_cache->m_file->m_view;
+		freeEntry->m_stamp = InterlockedIncrement64(&header->m_written);
+		freeEntry->m_aceValue = _aceValue;
+		freeEntry->m_key = key;
+		freeEntry->m_composition = *_composition;
+		freeEntry->m_solution = *o_solution;
+
+		// Everything has to be written before the slot is marked as ready, or a reader could see half of a solution.
+		MemoryBarrier();
+		freeEntry->m_state = c_entryReady;
+		InterlockedIncrement(&freeEntry->m_generation);
+		freeEntry->m_claimed = 0;
+	}
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#ifndef SOLUTION_CACHE_H_
+#define SOLUTION_CACHE_H_
+
+#include "MappedFile.h"
+#include "Solver.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The file solutions are cached in, next to wherever the program is run from.
+	/// </summary>
+	constexpr char c_solutionCacheFileName[] = "solutions.bjs";
+
+	/// <summary>
+	/// The amount of solutions the cache file can hold. Each one is about 4KB, so a full cache is about 16MB.<br>
+	/// Once every slot a composition can go in is full, the oldest of them is overwritten, so the cache keeps whatever's been solved most recently.
+	/// </summary>
+	constexpr auto c_solutionCacheCapacity = 4096;
+
+	/// <summary>
+	/// The most slots looked at for a composition, which are the only slots it can be cached in. Keeps lookups quick once the cache is nearly full.
+	/// </summary>
+	constexpr auto c_solutionCacheProbes = 32;
+
+	/// <summary>
+	/// Changed whenever the layout of the cache file, or the way it's solved, changes. Files from other versions are ignored.
+	/// </summary>
+	constexpr auto c_solutionCacheVersion = 3;
+
+	/// <summary>
+	/// How long a slot can be claimed for, in milliseconds, before it's assumed its writer died part way through and it's claimed again.<br>
+	/// A solution is already solved before its slot is claimed, so writing one only takes microseconds. Only a process that's crashed,
+	/// or been paused in a debugger for this long, ever gets near it. A paused writer that carries on afterwards can tear the slot's solution.
+	/// </summary>
+	constexpr auto c_solutionCacheClaimTimeout = 10000ll;
+
+	/// <summary>
+	/// The start of the cache file. The rules are written into it, so that a file solved under other rules is never used.
+	/// </summary>
+	struct SolutionCacheHeader
+	{
+		/// <summary>
+		/// Only written once everything else in the header is, so a file with this set is ready to use.
+		/// </summary>
+		volatile long m_magic;
+
+		int m_version;
+		int m_capacity;
+		int m_dealerStandValue;
+
+		/// <summary>
+		/// The amount of solutions ever written into the file. Each slot is stamped with this when it's written, so the oldest can be found.
+		/// </summary>
+		volatile long long m_written;
+	};
+
+	/// <summary>
+	/// One slot in the cache file. Slots are claimed by a single writer at a time, and are only ever changed again to be overwritten.
+	/// </summary>
+	struct SolutionCacheEntry
+	{
+		/// <summary>
+		/// 0 if the slot has never held a solution, and 2 once it has. Slots never go back to being empty.
+		/// </summary>
+		volatile long m_state;
+
+		/// <summary>
+		/// Counts up whenever a write starts or finishes, so it's odd while the slot is being written.<br>
+		/// A reader only trusts a copied solution if this was the same even number before and after copying it.
+		/// </summary>
+		volatile long m_generation;
+
+		/// <summary>
+		/// 0 unless the slot is claimed, in which case it's the writer's GetTickCount64 from when it claimed it.<br>
+		/// Claiming swaps the time in atomically, so the claim and its age can never be seen apart. If a writer dies before finishing,
+		/// its claim is left behind, and the slot is claimed again once it's older than "c_solutionCacheClaimTimeout".
+		/// </summary>
+		volatile long long m_claimed;
+
+		/// <summary>
+		/// The header's "m_written" from when this slot was last written. Smaller stamps are older.
+		/// </summary>
+		long long m_stamp;
+
+		int m_aceValue;
+		unsigned long long m_key;
+		Composition m_composition;
+		CompositionSolution m_solution;
+	};
+
+	/// <summary>
+	/// An on-disk table of every composition that's been solved, mapped into memory.<br>
+	/// Any amount of processes can share the same file. Solutions written by one are seen by the others straight away, and survive restarts.
+	/// </summary>
+	struct SolutionCache
+	{
+		MappedFile* m_file;
+		SolutionCacheEntry* m_entries;
+
+		/// <summary>
+		/// How many solutions were found in the cache, and how many had to be solved, by this process.
+		/// </summary>
+		long long m_hits;
+		long long m_misses;
+	};
+
+	/// <summary>
+	/// Open a cache file, creating it if it's writable and doesn't exist yet.
+	/// </summary>
+	/// <param name="_path">The path of the cache file.</param>
+	/// <param name="_writable">Whether new solutions are written into the file. If not, the file MUST already exist.</param>
+	/// <returns>A pointer to the cache in memory, or nullptr if the file couldn't be opened, or was made by another version or rule set.</returns>
+	SolutionCache* OpenSolutionCache(const char _path[], bool _writable);
+
+	/// <summary>
+	/// Close a cache file, then free the memory allocated to the cache and nullify its pointer.
+	/// </summary>
+	/// <param name="_cache">The cache to be closed.</param>
+	void CloseSolutionCache(SolutionCache*& _cache);
+
+	/// <summary>
+	/// Get the solution for a composition, from the cache if it's been solved before.<br>
+	/// Otherwise, it's solved now and added to the cache, as long as the cache is writable. If its slots are all full, the oldest is overwritten.
+	/// </summary>
+	/// <param name="_cache">The cache to look in. Can be nullptr, in which case the composition is always solved.</param>
+	/// <param name="_composition">The cards the dealer can still draw from, as given to SolveComposition.</param>
+	/// <param name="_aceValue">The integer value of Aces (should be 1 or 11).</param>
+	/// <param name="o_solution">The solution to be output into.</param>
+	void GetSolution(SolutionCache* _cache, const Composition* _composition, int _aceValue, CompositionSolution* o_solution);
+}
+
+#endif
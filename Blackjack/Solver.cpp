@@ -0,0 +1,104 @@
+#include "Solver.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// Deal the dealer every possible next card, and add the chance of each way their hand can end up.<br>
+	/// Each card is taken out of the counts while its branch is being followed, so that it can't be drawn again.
+	/// </summary>
+	static void SolveDealerHand(int _counts[c_valueClasses], const int _remaining, const int _total, const int _cards, const double _chance,
+		const int _aceValue, double o_outcomes[TOTAL_DEALER_OUTCOMES])
+	{
+		if (_total >= c_dealerStandValue)
+		{
+			// Just like IsHandValid, a natural is exactly 21 with only two cards.
+			const auto outcome = _total > 21 ? DEALER_OUTCOME_BUST :
+				_total == 21 && _cards == 2 ? DEALER_OUTCOME_NATURAL : (eDealerOutcome)(_total - c_dealerStandValue);
+			o_outcomes[outcome] += _chance;
+			return;
+		}
+
+		// The game would reshuffle here, but there's nothing left in the composition to reshuffle. It only happens with tiny compositions.
+		if (_remaining == 0)
+		{
+			o_outcomes[DEALER_OUTCOME_BUST] += _chance;
+			return;
+		}
+
+		for (auto valueClass = 0; valueClass < c_valueClasses; valueClass++)
+		{
+			if (_counts[valueClass] == 0)
+			{
+				continue;
+			}
+
+			const auto chance = _chance * _counts[valueClass] / _remaining;
+			_counts[valueClass]--;
+			SolveDealerHand(_counts, _remaining - 1, _total + GetClassValue(valueClass, _aceValue), _cards + 1, chance, _aceValue, o_outcomes);
+			_counts[valueClass]++;
+		}
+	}
+
+	int GetValueClass(const eRank _rank)
+	{
+		return _rank >= RANK_TEN ? c_valueClasses - 1 : (int)_rank;
+	}
+
+	void GetShoeComposition(const Shoe* _shoe, Composition* o_composition)
+	{
+		*o_composition = {};
+
+		const auto begin = _shoe->m_discardBegin + _shoe->m_discardSize + _shoe->m_inPlaySize;
+		const auto undealtSize = GetUndealtSize(_shoe);
+		for (auto cardIndex = 0; cardIndex < undealtSize; cardIndex++)
+		{
+			const auto position = (begin + cardIndex) % _shoe->m_size;
+			o_composition->m_counts[GetValueClass(_shoe->m_cards[position].m_rank)]++;
+		}
+	}
+
+	void SolveComposition(const Composition* _composition, const int _aceValue, CompositionSolution* o_solution)
+	{
+		*o_solution = {};
+
+		int counts[c_valueClasses];
+		auto remaining = 0;
+		for (auto valueClass = 0; valueClass < c_valueClasses; valueClass++)
+		{
+			counts[valueClass] = _composition->m_counts[valueClass];
+			remaining += counts[valueClass];
+		}
+
+		if (remaining == 0)
+		{
+			return;
+		}
+
+		for (auto upcard = 0; upcard < c_valueClasses; upcard++)
+		{
+			auto* outcomes = o_solution->m_dealerOutcomes[upcard];
+			SolveDealerHand(counts, remaining, GetClassValue(upcard, _aceValue), 1, 1.0, _aceValue, outcomes);
+
+			// A bust player only ties with a bust dealer, so even busting isn't a guaranteed loss.
+			const auto bustValue = outcomes[DEALER_OUTCOME_BUST] - 1.0;
+
+			// Every card is worth at least 1, so hitting only ever leads to higher totals. Working downwards means they're already solved.
+			for (auto total = c_solvedTotals - 1; total >= 0; total--)
+			{
+				o_solution->m_standValues[total][upcard] = GetStandValue(total, outcomes);
+
+				auto hitValue = 0.0;
+				for (auto valueClass = 0; valueClass < c_valueClasses; valueClass++)
+				{
+					const auto newTotal = total + GetClassValue(valueClass, _aceValue);
+					const auto value = newTotal > 21 ? bustValue :
+						o_solution->m_standValues[newTotal][upcard] > o_solution->m_hitValues[newTotal][upcard] ?
+						o_solution->m_standValues[newTotal][upcard] : o_solution->m_hitValues[newTotal][upcard];
+
+					hitValue += value * counts[valueClass] / remaining;
+				}
+				o_solution->m_hitValues[total][upcard] = hitValue;
+			}
+		}
+	}
+}
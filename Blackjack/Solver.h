@@ -0,0 +1,122 @@
+#pragma once
+
+#ifndef SOLVER_H_
+#define SOLVER_H_
+
+#include "Game.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The amount of different card values. Aces, Two to Nine, and every ten-valued card.
+	/// </summary>
+	constexpr auto c_valueClasses = 10;
+
+	/// <summary>
+	/// The amount of player totals that are solved, from 0 to 21.
+	/// </summary>
+	constexpr auto c_solvedTotals = 22;
+
+	/// <summary>
+	/// Every way the dealer's hand can end up, following the same rules as PlayDealerHand and CompareHands.<br>
+	/// Includes a value to refer to for the total amount of outcomes, which should not be used as an outcome ever.
+	/// </summary>
+	enum eDealerOutcome : int
+	{
+		DEALER_OUTCOME_17 = 0,
+		DEALER_OUTCOME_18,
+		DEALER_OUTCOME_19,
+		DEALER_OUTCOME_20,
+		DEALER_OUTCOME_21,
+		DEALER_OUTCOME_NATURAL,
+		DEALER_OUTCOME_BUST,
+		TOTAL_DEALER_OUTCOMES
+	};
+
+	/// <summary>
+	/// How many of each card value are left to be drawn. Suits don't matter, and neither do the faces of ten-valued cards.
+	/// </summary>
+	struct Composition
+	{
+		unsigned short m_counts[c_valueClasses];
+	};
+
+	/// <summary>
+	/// Everything that can be worked out exactly from a composition, for every dealer upcard.<br>
+	/// Values are the player's expected result in bets, where winning is +1, a natural is +1.5, and losing is -1.
+	/// </summary>
+	struct CompositionSolution
+	{
+		/// <summary>
+		/// The chance of each outcome of the dealer's hand, by upcard value class.
+		/// </summary>
+		double m_dealerOutcomes[c_valueClasses][TOTAL_DEALER_OUTCOMES];
+
+		/// <summary>
+		/// The player's expected result if they stand now, by their total and the dealer's upcard value class.
+		/// </summary>
+		double m_standValues[c_solvedTotals][c_valueClasses];
+
+		/// <summary>
+		/// The player's expected result if they hit now and then play on perfectly, by their total and the dealer's upcard value class.<br>
+		/// The player's own draws use the composition's chances as they are, without taking each drawn card out.
+		/// </summary>
+		double m_hitValues[c_solvedTotals][c_valueClasses];
+	};
+
+	/// <summary>
+	/// Get the value of every card in a value class.
+	/// </summary>
+	/// <param name="_valueClass">The value class, from 0 to "c_valueClasses" - 1.</param>
+	/// <param name="_aceValue">The integer value of Aces (should be 1 or 11).</param>
+	/// <returns>The value of the cards.</returns>
+	constexpr int GetClassValue(const int _valueClass, const int _aceValue)
+	{
+		return _valueClass == 0 ? _aceValue : _valueClass + 1;
+	}
+
+	/// <summary>
+	/// Get the player's expected result for standing on a total, from the chance of each dealer outcome.<br>
+	/// Can be evaluated at compile time, so that strategies built into the program follow exactly the same rules as the solver.
+	/// </summary>
+	/// <param name="_total">The player's hand value. MUST be 21 or under.</param>
+	/// <param name="_outcomes">The chance of each outcome of the dealer's hand.</param>
+	/// <returns>The expected result, in bets.</returns>
+	constexpr double GetStandValue(const int _total, const double _outcomes[TOTAL_DEALER_OUTCOMES])
+	{
+		// A dealer's natural beats even a non-natural 21, and a dealer that busts loses to any hand that hasn't.
+		auto value = _outcomes[DEALER_OUTCOME_BUST] - _outcomes[DEALER_OUTCOME_NATURAL];
+		for (auto outcome = 0; outcome <= DEALER_OUTCOME_21; outcome++)
+		{
+			const auto dealerTotal = outcome + c_dealerStandValue;
+			value += _total > dealerTotal ? _outcomes[outcome] : _total < dealerTotal ? -_outcomes[outcome] : 0.0;
+		}
+
+		return value;
+	}
+
+	/// <summary>
+	/// Get the value class of a rank. Aces are 0, Two to Nine are 1 to 8, and every ten-valued card is 9.
+	/// </summary>
+	/// <param name="_rank">The rank.</param>
+	/// <returns>The index of the rank in a composition.</returns>
+	int GetValueClass(eRank _rank);
+
+	/// <summary>
+	/// Get the composition of every undealt card in a shoe.
+	/// </summary>
+	/// <param name="_shoe">The shoe.</param>
+	/// <param name="o_composition">The composition to be output into.</param>
+	void GetShoeComposition(const Shoe* _shoe, Composition* o_composition);
+
+	/// <summary>
+	/// Work out the dealer's chances and the player's expected results for a composition, exactly.<br>
+	/// The dealer draws every card without replacement. This can take a while for large compositions with aces worth 1.
+	/// </summary>
+	/// <param name="_composition">The cards the dealer can still draw from. The dealer's upcard MUST already have been taken out.</param>
+	/// <param name="_aceValue">The integer value of Aces (should be 1 or 11).</param>
+	/// <param name="o_solution">The solution to be output into.</param>
+	void SolveComposition(const Composition* _composition, int _aceValue, CompositionSolution* o_solution);
+}
+
+#endif
@@ -0,0 +1,100 @@
+#include "Strategy.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The chance of drawing a card of a value class from an endless shoe. Ten-valued cards are four ranks out of thirteen.
+	/// </summary>
+	constexpr double GetEndlessClassChance(const int _valueClass)
+	{
+		return _valueClass == c_valueClasses - 1 ? 4.0 / 13.0 : 1.0 / 13.0;
+	}
+
+	/// <summary>
+	/// Work out the basic strategy for a rule set, as if every card was drawn from an endless shoe.<br>
+	/// This is only ever evaluated while compiling. Since no card ever runs out, the dealer is worked out total by total rather than card by card.
+	/// </summary>
+	constexpr StrategyTable GenerateBasicStrategy(const int _aceValue)
+	{
+		StrategyTable table{};
+
+		for (auto upcard = 0; upcard < c_valueClasses; upcard++)
+		{
+			double outcomes[TOTAL_DEALER_OUTCOMES]{};
+
+			// The chance of the dealer having each total below their stand value, with at least two cards.
+			double drawing[c_dealerStandValue]{};
+
+			// The second card is the only one that can make a natural.
+			for (auto valueClass = 0; valueClass < c_valueClasses; valueClass++)
+			{
+				const auto total = GetClassValue(upcard, _aceValue) + GetClassValue(valueClass, _aceValue);
+				const auto chance = GetEndlessClassChance(valueClass);
+
+				if (total < c_dealerStandValue)
+				{
+					drawing[total] += chance;
+				}
+				else
+				{
+					outcomes[total > 21 ? DEALER_OUTCOME_BUST : total == 21 ? DEALER_OUTCOME_NATURAL : total - c_dealerStandValue] += chance;
+				}
+			}
+
+			// Every card adds to the total, so working upwards means each total is finished before it's drawn from.
+			for (auto total = 0; total < c_dealerStandValue; total++)
+			{
+				for (auto valueClass = 0; valueClass < c_valueClasses; valueClass++)
+				{
+					const auto newTotal = total + GetClassValue(valueClass, _aceValue);
+					const auto chance = drawing[total] * GetEndlessClassChance(valueClass);
+
+					if (newTotal < c_dealerStandValue)
+					{
+						drawing[newTotal] += chance;
+					}
+					else
+					{
+						outcomes[newTotal > 21 ? DEALER_OUTCOME_BUST : newTotal - c_dealerStandValue] += chance;
+					}
+				}
+			}
+
+			// Just like SolveComposition, the player's totals are worked out downwards, so hitting only ever leads to ones already solved.
+			double bestValues[c_solvedTotals]{};
+			for (auto total = c_solvedTotals - 1; total >= 0; total--)
+			{
+				const auto standValue = GetStandValue(total, outcomes);
+
+				auto hitValue = 0.0;
+				for (auto valueClass = 0; valueClass < c_valueClasses; valueClass++)
+				{
+					const auto newTotal = total + GetClassValue(valueClass, _aceValue);
+					hitValue += GetEndlessClassChance(valueClass) * (newTotal > 21 ? outcomes[DEALER_OUTCOME_BUST] - 1.0 : bestValues[newTotal]);
+				}
+
+				// Standing wins ties, since it's the same result without touching the shoe.
+				table.m_actions[total][upcard] = hitValue > standValue ? PLAYER_ACTION_HIT : PLAYER_ACTION_STAND;
+				bestValues[total] = hitValue > standValue ? hitValue : standValue;
+			}
+		}
+
+		return table;
+	}
+
+	/// <summary>
+	/// Every built-in basic strategy. Aces worth 1 come first, then Aces worth 11.
+	/// </summary>
+	constexpr StrategyTable c_basicStrategies[] = { GenerateBasicStrategy(1), GenerateBasicStrategy(11) };
+
+	// These can never be wrong under any rules, so if they are, the generator is broken. Failing here stops it from ever being shipped.
+	static_assert(c_basicStrategies[0].m_actions[21][0] == PLAYER_ACTION_STAND && c_basicStrategies[1].m_actions[21][0] == PLAYER_ACTION_STAND,
+		"Basic strategy should always stand on 21.");
+	static_assert(c_basicStrategies[0].m_actions[4][9] == PLAYER_ACTION_HIT && c_basicStrategies[1].m_actions[4][9] == PLAYER_ACTION_HIT,
+		"Basic strategy should always hit on 4.");
+
+	const StrategyTable* GetBasicStrategy(const int _aceValue)
+	{
+		return &c_basicStrategies[_aceValue == 11 ? 1 : 0];
+	}
+}
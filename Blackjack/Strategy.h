@@ -0,0 +1,28 @@
+#pragma once
+
+#ifndef STRATEGY_H_
+#define STRATEGY_H_
+
+#include "Solver.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The best action for every hand value against every dealer upcard, under one rule set.<br>
+	/// Indexed by the player's hand value, then the value class of the dealer's face-up card.
+	/// </summary>
+	struct StrategyTable
+	{
+		ePlayerAction m_actions[c_solvedTotals][c_valueClasses];
+	};
+
+	/// <summary>
+	/// Get the basic strategy for a rule set. Every basic strategy is worked out while compiling, and stored in the program itself.<br>
+	/// This should be looked up once, outside of any decisions. Each decision is then only a single read from the table.
+	/// </summary>
+	/// <param name="_aceValue">The integer value of Aces (should be 1 or 11).</param>
+	/// <returns>A pointer to the read-only strategy table.</returns>
+	const StrategyTable* GetBasicStrategy(int _aceValue);
+}
+
+#endif
@@ -0,0 +1,240 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "Game.h"
+
+namespace blackjack
+{
+	InputTrace* CreateInputTrace(const unsigned long long _seed)
+	{
+		// Traces are far too big for the stack, so they're always kept in the heap.
+		auto* trace = new InputTrace;
+		trace->m_seed = _seed;
+		trace->m_size = 0;
+		return trace;
+	}
+
+	void DestroyInputTrace(InputTrace*& _trace)
+	{
+		delete _trace;
+		_trace = nullptr;
+	}
+
+	void RecordInput(InputTrace* _trace, const int _input)
+	{
+		if (_trace->m_size >= c_maxTraceInputs)
+		{
+			return;
+		}
+
+		_trace->m_inputs[_trace->m_size++] = _input;
+	}
+
+	bool SaveInputTrace(const InputTrace* _trace, const char _path[])
+	{
+		FILE* file = nullptr;
+		if (fopen_s(&file, _path, "w") != 0 || file == nullptr)
+		{
+			return false;
+		}
+
+		fprintf(file, "%s\n%llu\n", c_traceHeader, _trace->m_seed);
+		for (auto inputIndex = 0; inputIndex < _trace->m_size; inputIndex++)
+		{
+			fprintf(file, "%d\n", _trace->m_inputs[inputIndex]);
+		}
+
+		// Writes are buffered, so a full disk might only be noticed once the file is closed.
+		return fclose(file) == 0;
+	}
+
+	InputTrace* LoadInputTrace(const char _path[])
+	{
+		FILE* file = nullptr;
+		if (fopen_s(&file, _path, "r") != 0 || file == nullptr)
+		{
+			return nullptr;
+		}
+
+		// The header is read as a whole line, so that traces from a different version aren't mistaken for this one.
+		char header[sizeof(c_traceHeader) + 1] = {};
+		unsigned long long seed = 0;
+		if (fgets(header, sizeof(header), file) == nullptr || strncmp(header, c_traceHeader, sizeof(c_traceHeader) - 1) != 0 ||
+			header[sizeof(c_traceHeader) - 1] != '\n' || fscanf_s(file, "%llu", &seed) != 1)
+		{
+			fclose(file);
+			return nullptr;
+		}
+
+		auto* trace = CreateInputTrace(seed);
+		auto input = 0;
+		while (trace->m_size < c_maxTraceInputs && fscanf_s(file, "%d", &input) == 1)
+		{
+			RecordInput(trace, input);
+		}
+
+		fclose(file);
+		return trace;
+	}
+
+	int RunRecording(const char _path[])
+	{
+		// The seed is taken before the game is played, so that it's the only thing the cards depend on.
+		auto* game = InitGame(false, 1, false);
+		const auto seed = (unsigned long long)rand() << 32 | (unsigned long long)rand();
+		ResetGame(game, seed);
+
+		auto* trace = CreateInputTrace(seed);
+		GameLoop(game, trace);
+		EndGame(game);
+
+		const auto saved = SaveInputTrace(trace, _path);
+		if (saved)
+		{
+			std::cout << "Recorded " << trace->m_size << " inputs to " << _path << "\n";
+		}
+		else
+		{
+			std::cout << "Couldn't write the trace to " << _path << "\n";
+		}
+
+		DestroyInputTrace(trace);
+		return saved ? 0 : 1;
+	}
+
+	/// <summary>
+	/// Find which step an input belongs to, by what the game displays in response to it.
+	/// </summary>
+	/// <param name="_state">The state the game was waiting at when it was given the input.</param>
+	/// <param name="_input">The input given to the game.</param>
+	/// <returns>The step the input is timed as.</returns>
+	static eReplayStep GetReplayStep(const eGameState _state, const int _input)
+	{
+		switch (_state)
+		{
+			case GAME_STATE_SELECT_BET:
+			{
+				return REPLAY_STEP_SELECT_BET;
+			}
+
+			// The initial deal is displayed straight after the ace value is chosen.
+			case GAME_STATE_SELECT_ACE_VALUE:
+			{
+				return REPLAY_STEP_INITIAL_DEAL;
+			}
+
+			case GAME_STATE_PLAYER_TURN:
+			{
+				return _input == 1 ? REPLAY_STEP_HIT : REPLAY_STEP_DEALER_TURN;
+			}
+
+			// Going bust still reveals the dealer's hand, once the player has seen that they've gone bust.
+			case GAME_STATE_PLAYER_BUST:
+			{
+				return REPLAY_STEP_DEALER_TURN;
+			}
+
+			default:
+			{
+				return REPLAY_STEP_OTHER;
+			}
+		}
+	}
+
+	double GetLatencyQuantile(const std::vector<long long>& _latencies, const double _quantile)
+	{
+		const auto index = (size_t)((double)(_latencies.size() - 1) * _quantile);
+		return (double)_latencies[index] / 1000.0;
+	}
+
+	int RunReplay(const char _path[], const int _replays, const long long _budget)
+	{
+		auto* trace = LoadInputTrace(_path);
+		if (trace == nullptr)
+		{
+			std::cout << "Couldn't read a trace from " << _path << "\n";
+			return 1;
+		}
+
+		// The game is created just like it was recorded, so that the same seed deals the same cards.
+		auto* game = InitGame(false, 1, false);
+		std::vector<long long> latencies[TOTAL_REPLAY_STEPS];
+
+		auto matches = true;
+		for (auto replay = 0; replay < _replays && matches; replay++)
+		{
+			ResetGame(game, trace->m_seed);
+			StartGame(game);
+
+			for (auto inputIndex = 0; inputIndex < trace->m_size; inputIndex++)
+			{
+				// If the game's rules or dealing have changed since the trace was recorded, its inputs won't fit the game any more.
+				const auto input = trace->m_inputs[inputIndex];
+				const auto inputMax = GetInputMax(game);
+				if (game->m_state == GAME_STATE_FINISHED || (inputMax == 0 ? input != 0 : input < 1 || input > inputMax))
+				{
+					matches = false;
+					break;
+				}
+
+				// Each step is timed until everything it displays has actually been written, just like the player would see it.
+				const auto step = GetReplayStep(game->m_state, input);
+				const auto start = std::chrono::steady_clock::now();
+				AdvanceGame(game, input);
+				*game->m_output << std::flush;
+				const auto end = std::chrono::steady_clock::now();
+
+				latencies[step].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+			}
+
+			// Every replay plays exactly the same steps, so once the first is done, each list knows exactly how big it'll end up.
+			// Reserving that means no list is ever moved while the rest are being timed, without reserving every input for every step.
+			if (replay == 0)
+			{
+				for (auto& stepLatencies : latencies)
+				{
+					stepLatencies.reserve(stepLatencies.size() * (size_t)_replays);
+				}
+			}
+		}
+
+		EndGame(game);
+		DestroyInputTrace(trace);
+
+		if (!matches)
+		{
+			std::cout << "\nThe trace " << _path << " doesn't match how this build plays. It needs to be recorded again.\n";
+			return 1;
+		}
+
+		std::cout << "\nReplayed " << _path << " " << _replays << " times.\n";
+		std::cout << "Latency (microseconds):\n";
+
+		auto withinBudget = true;
+		for (auto step = 0; step < TOTAL_REPLAY_STEPS; step++)
+		{
+			auto& stepLatencies = latencies[step];
+			if (stepLatencies.empty())
+			{
+				continue;
+			}
+
+			std::sort(stepLatencies.begin(), stepLatencies.end());
+			const auto p99 = GetLatencyQuantile(stepLatencies, 0.99);
+			const auto overBudget = _budget > 0 && p99 > (double)_budget;
+			withinBudget = withinBudget && !overBudget;
+
+			std::cout << c_replayStepNames[step] << " (" << stepLatencies.size() << ") 50%: " << GetLatencyQuantile(stepLatencies, 0.5) <<
+				" 99%: " << p99 << " Max: " << GetLatencyQuantile(stepLatencies, 1.0) << (overBudget ? " OVER BUDGET" : "") << "\n";
+		}
+
+		return withinBudget ? 0 : 1;
+	}
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <vector>
+
+namespace blackjack
+{
+	/// <summary>
+	/// The command line argument that plays a game on the console while recording every input, rather than opening the menu.<br>
+	/// Recording is started as "Blackjack.exe --record (trace file)".
+	/// </summary>
+	constexpr char c_recordArgument[] = "--record";
+
+	/// <summary>
+	/// The command line argument that replays a recorded game, timing how long the game takes to respond to each input.<br>
+	/// Replays are started as "Blackjack.exe --replay (trace file) (repetitions) (budget)", where the repetitions and budget are optional.<br>
+	/// The budget is in microseconds. If any step's 99th percentile is over it, the replay exits with 1.
+	/// </summary>
+	constexpr char c_replayArgument[] = "--replay";
+
+	/// <summary>
+	/// The most inputs a trace can hold. Anything after this isn't recorded.
+	/// </summary>
+	constexpr auto c_maxTraceInputs = 65536;
+
+	/// <summary>
+	/// The amount of times a trace is replayed, if it isn't given.
+	/// </summary>
+	constexpr auto c_defaultReplays = 100;
+
+	/// <summary>
+	/// The first line of every trace file, which changes whenever the format does.
+	/// </summary>
+	constexpr char c_traceHeader[] = "BlackjackTrace 1";
+
+	/// <summary>
+	/// Every step of the game that replays are timed by. Each input belongs to the step it makes the game display.<br>
+	/// Includes a value to refer to for the total amount of steps, which should not be used as a step ever.
+	/// </summary>
+	enum eReplayStep : int
+	{
+		REPLAY_STEP_SELECT_BET = 0,
+		REPLAY_STEP_INITIAL_DEAL,
+		REPLAY_STEP_HIT,
+		REPLAY_STEP_DEALER_TURN,
+		REPLAY_STEP_OTHER,
+		TOTAL_REPLAY_STEPS
+	};
+
+	/// <summary>
+	/// String values for every step name.<br>
+	/// Includes an additional blank value for the TOTAL_REPLAY_STEPS value.
+	/// </summary>
+	constexpr char c_replayStepNames[][13] = { "Select Bet", "Initial Deal", "Hit", "Dealer Turn", "Other", "" };
+
+	/// <summary>
+	/// A recorded game. The seed decides every card, so the same inputs always play out the same way.
+	/// </summary>
+	struct InputTrace
+	{
+		unsigned long long m_seed;
+
+		/// <summary>
+		/// Every input given to the game, in order. Pauses are recorded as 0, just like AdvanceGame takes them.
+		/// </summary>
+		int m_inputs[c_maxTraceInputs];
+		int m_size;
+	};
+
+	/// <summary>
+	/// Allocate memory to and create a new, empty trace in the heap.
+	/// </summary>
+	/// <param name="_seed">The seed the recorded game was reset with.</param>
+	/// <returns>A pointer to the created trace in memory.</returns>
+	InputTrace* CreateInputTrace(unsigned long long _seed);
+
+	/// <summary>
+	/// Free the memory allocated to a trace, and nullify its pointer.
+	/// </summary>
+	/// <param name="_trace">The trace to be de-allocated.</param>
+	void DestroyInputTrace(InputTrace*& _trace);
+
+	/// <summary>
+	/// Add an input onto the end of a trace. If the trace is full, the input is ignored.
+	/// </summary>
+	/// <param name="_trace">The trace to record into.</param>
+	/// <param name="_input">The input given to the game.</param>
+	void RecordInput(InputTrace* _trace, int _input);
+
+	/// <summary>
+	/// Write a trace to a file, as text. The seed is on the second line, and every input after it is on its own line.
+	/// </summary>
+	/// <param name="_trace">The trace to be saved.</param>
+	/// <param name="_path">The path of the file. Anything already in it is overwritten.</param>
+	/// <returns>True if the file was written.</returns>
+	bool SaveInputTrace(const InputTrace* _trace, const char _path[]);
+
+	/// <summary>
+	/// Read a trace from a file written by SaveInputTrace.
+	/// </summary>
+	/// <param name="_path">The path of the file.</param>
+	/// <returns>A pointer to the loaded trace in memory, or nullptr if the file couldn't be read or isn't a trace.</returns>
+	InputTrace* LoadInputTrace(const char _path[]);
+
+	/// <summary>
+	/// Play a game on the console, just like a new game from the menu, and save every input to a trace file once it's finished.<br>
+	/// Reshuffles aren't prepared in the background, since that would make the cards depend on timing rather than only on the seed.
+	/// </summary>
+	/// <param name="_path">The path of the trace file.</param>
+	/// <returns>The process exit code. 0 if the trace was saved.</returns>
+	int RunRecording(const char _path[]);
+
+	/// <summary>
+	/// Get a quantile from a sorted list of latencies. Shared by replays and the server's load generator.
+	/// </summary>
+	/// <param name="_latencies">Every latency measured, in nanoseconds, sorted from fastest to slowest. MUST NOT be empty.</param>
+	/// <param name="_quantile">The quantile, from 0 to 1.</param>
+	/// <returns>The latency at that quantile, in microseconds.</returns>
+	double GetLatencyQuantile(const std::vector<long long>& _latencies, double _quantile);
+
+	/// <summary>
+	/// Replay a trace file many times on the console, timing how long the game takes to display its response to each input.<br>
+	/// Reports the 50th and 99th percentile, and the slowest, of every step.
+	/// </summary>
+	/// <param name="_path">The path of the trace file.</param>
+	/// <param name="_replays">The amount of times the trace is replayed.</param>
+	/// <param name="_budget">The slowest any step's 99th percentile is allowed to be, in microseconds. 0 for no budget.</param>
+	/// <returns>The process exit code. 0 if the trace was replayed and every step was within the budget.</returns>
+	int RunReplay(const char _path[], int _replays, long long _budget);
+}
+
+#endif
@@ -0,0 +1,103 @@
+#include "Tracepoints.h"
+
+#include <cstdlib>
+#include <initializer_list>
+
+#ifdef BLACKJACK_TRACEPOINTS
+#include <windows.h>
+#include <TraceLoggingProvider.h>
+#include <winmeta.h>
+
+// The provider is defined outside of the namespace, since the macro declares some of its storage with C linkage.
+TRACELOGGING_DEFINE_PROVIDER(c_tracepointProvider, "Blackjack",
+	(0xc340fd6c, 0x4425, 0x5167, 0xdf, 0x48, 0xc9, 0x43, 0x26, 0xfc, 0xa8, 0x9a));
+#endif
+
+namespace blackjack
+{
+	volatile unsigned long long g_enabledTracepoints = 0;
+
+#ifdef BLACKJACK_TRACEPOINTS
+	/// <summary>
+	/// Called by ETW whenever a session enables or disables the provider. The provider's own state has already been updated by then,
+	/// so it's asked which keywords are enabled across every session, rather than working it out from just the one that changed.
+	/// </summary>
+	static void NTAPI OnTracepointsChanged(LPCGUID, ULONG, UCHAR, ULONGLONG, ULONGLONG, PEVENT_FILTER_DESCRIPTOR, PVOID)
+	{
+		unsigned long long enabled = 0;
+		for (auto keyword : { c_tracepointKeywordDeal, c_tracepointKeywordShuffle, c_tracepointKeywordRound })
+		{
+			if (TraceLoggingProviderEnabled(c_tracepointProvider, 0, keyword))
+			{
+				enabled |= keyword;
+			}
+		}
+
+		g_enabledTracepoints = enabled;
+	}
+
+	/// <summary>
+	/// Unregister the provider on the way out, so that ETW isn't left holding a callback into a program that's gone.
+	/// </summary>
+	static void UnregisterTracepoints()
+	{
+		g_enabledTracepoints = 0;
+		TraceLoggingUnregister(c_tracepointProvider);
+	}
+#endif
+
+	void RegisterTracepoints()
+	{
+#ifdef BLACKJACK_TRACEPOINTS
+		if (SUCCEEDED(TraceLoggingRegisterEx(c_tracepointProvider, OnTracepointsChanged, nullptr)))
+		{
+			atexit(UnregisterTracepoints);
+		}
+#endif
+	}
+
+	// Every tracepoint is only called once its keyword is known to be enabled, but TraceLoggingWrite checks again anyway.
+	// The deal tracepoint fires more than anything else, so it's only written at verbose level, and the rest at information level.
+
+	void WriteDealCardTracepoint(const Card* _card, const int _undealt, const int _runningCount)
+	{
+#ifdef BLACKJACK_TRACEPOINTS
+		TraceLoggingWrite(c_tracepointProvider, "DealCard", TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE), TraceLoggingKeyword(c_tracepointKeywordDeal),
+			TraceLoggingInt32((int)_card->m_rank, "Rank"), TraceLoggingInt32((int)_card->m_suit, "Suit"),
+			TraceLoggingInt32(_undealt, "Undealt"), TraceLoggingInt32(_runningCount, "RunningCount"));
+#endif
+	}
+
+	void WriteReshuffleTracepoint(const int _cards, const char _source[])
+	{
+#ifdef BLACKJACK_TRACEPOINTS
+		TraceLoggingWrite(c_tracepointProvider, "Reshuffle", TraceLoggingLevel(WINEVENT_LEVEL_INFO), TraceLoggingKeyword(c_tracepointKeywordShuffle),
+			TraceLoggingInt32(_cards, "Cards"), TraceLoggingString(_source, "Source"));
+#endif
+	}
+
+	void WriteShuffleShoeTracepoint(const int _cards)
+	{
+#ifdef BLACKJACK_TRACEPOINTS
+		TraceLoggingWrite(c_tracepointProvider, "ShuffleShoe", TraceLoggingLevel(WINEVENT_LEVEL_INFO), TraceLoggingKeyword(c_tracepointKeywordShuffle),
+			TraceLoggingInt32(_cards, "Cards"));
+#endif
+	}
+
+	void WriteDealerTurnTracepoint(const int _total, const int _cards)
+	{
+#ifdef BLACKJACK_TRACEPOINTS
+		TraceLoggingWrite(c_tracepointProvider, "DealerTurn", TraceLoggingLevel(WINEVENT_LEVEL_INFO), TraceLoggingKeyword(c_tracepointKeywordRound),
+			TraceLoggingInt32(_total, "DealerTotal"), TraceLoggingInt32(_cards, "DealerCards"));
+#endif
+	}
+
+	void WritePayoutTracepoint(const eHandValidityComparison _result, const int _bet, const int _payout, const int _playerTotal, const int _dealerTotal)
+	{
+#ifdef BLACKJACK_TRACEPOINTS
+		TraceLoggingWrite(c_tracepointProvider, "Payout", TraceLoggingLevel(WINEVENT_LEVEL_INFO), TraceLoggingKeyword(c_tracepointKeywordRound),
+			TraceLoggingInt32((int)_result, "Result"), TraceLoggingInt32(_bet, "Bet"), TraceLoggingInt32(_payout, "Payout"),
+			TraceLoggingInt32(_playerTotal, "PlayerTotal"), TraceLoggingInt32(_dealerTotal, "DealerTotal"));
+#endif
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#ifndef TRACEPOINTS_H_
+#define TRACEPOINTS_H_
+
+#include "Card.h"
+#include "Hand.h"
+
+// Tracepoints are static ETW events, written through TraceLogging by the "Blackjack" provider (GUID c340fd6c-4425-5167-df48-c94326fca89a).
+// The GUID is the one ETW tools derive from the name, so any session can enable it as "*Blackjack", i.e. "tracelog -start bj -guid *Blackjack".
+// Until a session enables a tracepoint's keyword, the tracepoint is a single check of a flag, and its arguments aren't even evaluated.
+// ETW stamps every event with the time and the thread it was written on, so none of the tracepoints need to carry their own timestamp.
+// Defining BLACKJACK_NO_TRACEPOINTS removes every tracepoint from the build entirely.
+#if defined(_WIN32) && !defined(BLACKJACK_NO_TRACEPOINTS)
+#define BLACKJACK_TRACEPOINTS
+#endif
+
+#ifdef BLACKJACK_TRACEPOINTS
+#define TRACEPOINT_IF_ENABLED(_keyword, _write) ((blackjack::g_enabledTracepoints & (_keyword)) != 0 ? _write : (void)0)
+#else
+#define TRACEPOINT_IF_ENABLED(_keyword, _write) (void)0
+#endif
+
+#define TRACEPOINT_DEAL_CARD(_card, _undealt, _runningCount) \
+	TRACEPOINT_IF_ENABLED(blackjack::c_tracepointKeywordDeal, blackjack::WriteDealCardTracepoint(_card, _undealt, _runningCount))
+#define TRACEPOINT_RESHUFFLE(_cards, _source) \
+	TRACEPOINT_IF_ENABLED(blackjack::c_tracepointKeywordShuffle, blackjack::WriteReshuffleTracepoint(_cards, _source))
+#define TRACEPOINT_SHUFFLE_SHOE(_cards) \
+	TRACEPOINT_IF_ENABLED(blackjack::c_tracepointKeywordShuffle, blackjack::WriteShuffleShoeTracepoint(_cards))
+#define TRACEPOINT_DEALER_TURN(_total, _cards) \
+	TRACEPOINT_IF_ENABLED(blackjack::c_tracepointKeywordRound, blackjack::WriteDealerTurnTracepoint(_total, _cards))
+#define TRACEPOINT_PAYOUT(_result, _bet, _payout, _playerTotal, _dealerTotal) \
+	TRACEPOINT_IF_ENABLED(blackjack::c_tracepointKeywordRound, blackjack::WritePayoutTracepoint(_result, _bet, _payout, _playerTotal, _dealerTotal))
+
+namespace blackjack
+{
+	/// <summary>
+	/// Keywords a session can enable tracepoints by, so that the very frequent deal tracepoint can be left out.
+	/// </summary>
+	constexpr unsigned long long c_tracepointKeywordDeal = 0x1;
+	constexpr unsigned long long c_tracepointKeywordShuffle = 0x2;
+	constexpr unsigned long long c_tracepointKeywordRound = 0x4;
+
+	/// <summary>
+	/// Every keyword that any ETW session currently has enabled. Kept up to date by the provider's callback, and only ever read anywhere else.<br>
+	/// The lockstep engine has no tracepoints of its own, so simulations that start while this is set use the scalar engine.
+	/// </summary>
+	extern volatile unsigned long long g_enabledTracepoints;
+
+	/// <summary>
+	/// Register the tracepoint provider with ETW, so sessions can enable it. Tracepoints written before this are simply dropped.<br>
+	/// The provider is unregistered again automatically when the program exits. Does nothing if the tracepoints aren't built.
+	/// </summary>
+	void RegisterTracepoints();
+
+	/// <summary>
+	/// Write a card being dealt out of the shoe, along with what's left in the shoe afterwards. Use TRACEPOINT_DEAL_CARD instead.
+	/// </summary>
+	/// <param name="_card">The card that was dealt.</param>
+	/// <param name="_undealt">The amount of cards left to be dealt.</param>
+	/// <param name="_runningCount">The shoe's Hi-Lo running count, including the dealt card.</param>
+	void WriteDealCardTracepoint(const Card* _card, int _undealt, int _runningCount);
+
+	/// <summary>
+	/// Write the discard pile being shuffled back into an empty shoe. Use TRACEPOINT_RESHUFFLE instead.
+	/// </summary>
+	/// <param name="_cards">The amount of cards in the discard pile.</param>
+	/// <param name="_source">Where the new order came from: "Pipeline", "Generated", or "Library".</param>
+	void WriteReshuffleTracepoint(int _cards, const char _source[]);
+
+	/// <summary>
+	/// Write every undealt card in the shoe being shuffled, which happens whenever a game is created or reset. Use TRACEPOINT_SHUFFLE_SHOE instead.
+	/// </summary>
+	/// <param name="_cards">The amount of cards shuffled.</param>
+	void WriteShuffleShoeTracepoint(int _cards);
+
+	/// <summary>
+	/// Write the dealer's hand once they've finished drawing. Use TRACEPOINT_DEALER_TURN instead.
+	/// </summary>
+	/// <param name="_total">The total value of the dealer's hand.</param>
+	/// <param name="_cards">The amount of cards in the dealer's hand.</param>
+	void WriteDealerTurnTracepoint(int _total, int _cards);
+
+	/// <summary>
+	/// Write the result of a round, and how much the player was paid for it. Use TRACEPOINT_PAYOUT instead.
+	/// </summary>
+	/// <param name="_result">The result of the round.</param>
+	/// <param name="_bet">The player's bet.</param>
+	/// <param name="_payout">The amount paid back to the player, including their bet.</param>
+	/// <param name="_playerTotal">The total value of the player's hand.</param>
+	/// <param name="_dealerTotal">The total value of the dealer's hand.</param>
+	void WritePayoutTracepoint(eHandValidityComparison _result, int _bet, int _payout, int _playerTotal, int _dealerTotal);
+}
+
+#endif
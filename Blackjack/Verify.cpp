@@ -0,0 +1,612 @@
+#include "Verify.h"
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "Game.h"
+#include "Lockstep.h"
+#include "PackedHand.h"
+#include "Random.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The amount of random cases a thread claims at once. Each batch is seeded by its index, so the cases don't depend on the thread count.
+	/// </summary>
+	constexpr auto c_verifyBatchSize = 1 << 16;
+
+	/// <summary>
+	/// The ace values every exhaustive check is made with.
+	/// </summary>
+	constexpr int c_verifyAceValues[] = { 1, 11 };
+
+	/// <summary>
+	/// The amount of simulations, each with random settings, that are played by both the scalar and lockstep engines.
+	/// </summary>
+	constexpr auto c_verifySimulations = 32;
+
+	/// <summary>
+	/// The amount of sessions in each of those simulations.
+	/// </summary>
+	constexpr auto c_verifySimulationSessions = 2048;
+
+	/// <summary>
+	/// Every packed hand fits in 18 bits, so a table this big has room for one hand per packed value.
+	/// </summary>
+	constexpr auto c_packedHandValues = 1 << 18;
+
+	/// <summary>
+	/// Everything a worker thread finds. Each thread only ever writes to its own.
+	/// </summary>
+	struct VerifyResult
+	{
+		VerifyCase m_failure;
+		eVerifyCheck m_check;
+		long long m_cases;
+	};
+
+	/// <summary>
+	/// Fill a case with random hands. Small hands are where naturals (and most edge cases) are, so half of the hands have 3 cards or fewer.
+	/// </summary>
+	static void GenerateVerifyCase(Random* _random, VerifyCase* o_case)
+	{
+		const auto bits = NextRandom(_random);
+
+		for (auto hand = 0; hand < c_verifyHands; hand++)
+		{
+			const auto size = bits >> hand & 1 ? RandomRange(_random, 4) : RandomRange(_random, c_maxHandSize + 1);
+			o_case->m_hands[hand].m_size = size;
+
+			// Every random number is split into four cards, with the rank taken from the top of each 16 bits and the suit from the bottom.
+			auto cardBits = 0ull;
+			for (auto cardIndex = 0; cardIndex < size; cardIndex++)
+			{
+				if (cardIndex % 4 == 0)
+				{
+					cardBits = NextRandom(_random);
+				}
+
+				const auto chunk = (unsigned int)(cardBits >> cardIndex % 4 * 16 & 0xFFFF);
+				auto& card = o_case->m_hands[hand].m_cards[cardIndex];
+				card.m_rank = (eRank)(chunk * TOTAL_RANKS >> 16);
+				card.m_suit = (eSuit)(chunk & 3);
+				card.m_visible = cardIndex > 0 || (bits >> (hand + 2) & 1) != 0;
+			}
+		}
+
+		o_case->m_aceValue = bits >> 4 & 1 ? 11 : 1;
+		o_case->m_bet = 1 + (int)(bits >> 8 & (c_maxPackedPayoutBet - 1));
+	}
+
+	/// <summary>
+	/// Take a card out of a case's hand, moving every card after it down one.
+	/// </summary>
+	static void RemoveVerifyCard(VerifyCase* _case, const int _hand, const int _card)
+	{
+		for (auto cardIndex = _card; cardIndex < _case->m_hands[_hand].m_size - 1; cardIndex++)
+		{
+			_case->m_hands[_hand].m_cards[cardIndex] = _case->m_hands[_hand].m_cards[cardIndex + 1];
+		}
+		_case->m_hands[_hand].m_size--;
+	}
+
+	/// <summary>
+	/// Check the single hand in the first slot of a case with every ace value, first face-up, then with each different rank in it face-down.
+	/// </summary>
+	/// <returns>The first check that didn't match, or TOTAL_VERIFY_CHECKS if they all did.</returns>
+	static eVerifyCheck VerifyEveryFace(VerifyCase* _case, Hand* o_hands, long long* o_checked)
+	{
+		auto* cards = _case->m_hands[0].m_cards;
+		const auto size = _case->m_hands[0].m_size;
+
+		for (auto hidden = -1; hidden < size; hidden++)
+		{
+			// The cards are in order of rank, so a rank that matches the card before it has already been tried face-down.
+			if (hidden > 0 && cards[hidden].m_rank == cards[hidden - 1].m_rank)
+			{
+				continue;
+			}
+
+			// Only the first card can be face-down, so the hidden card is swapped to the front (and swapped back afterwards).
+			if (hidden >= 0)
+			{
+				const auto card = cards[0];
+				cards[0] = cards[hidden];
+				cards[hidden] = card;
+				cards[0].m_visible = false;
+			}
+
+			for (const auto aceValue : c_verifyAceValues)
+			{
+				_case->m_aceValue = aceValue;
+
+				const auto check = FindMismatch(_case);
+				if (check != TOTAL_VERIFY_CHECKS)
+				{
+					return check;
+				}
+				(*o_checked)++;
+			}
+
+			// Every packed value is only kept once, since every hand with the same packed value compares the same way.
+			auto& kept = o_hands[PackHand(&_case->m_hands[0])];
+			if (kept.m_size < 0)
+			{
+				kept = _case->m_hands[0];
+			}
+
+			if (hidden >= 0)
+			{
+				cards[0].m_visible = true;
+
+				const auto card = cards[0];
+				cards[0] = cards[hidden];
+				cards[hidden] = card;
+			}
+		}
+
+		return TOTAL_VERIFY_CHECKS;
+	}
+
+	/// <summary>
+	/// Check every hand of ranks from the given rank upwards, added onto the hand in the first slot of a case.<br>
+	/// Cards are always added in order of rank, so each combination of ranks is only checked once, however many orders it could be dealt in.<br>
+	/// Only hands that can be dealt are checked. No card is dealt to a hand that's bust even with Aces worth 1, so that's where each hand stops.
+	/// </summary>
+	/// <returns>The first check that didn't match, or TOTAL_VERIFY_CHECKS if they all did.</returns>
+	static eVerifyCheck VerifyEveryHand(VerifyCase* _case, const int _minRank, Hand* o_hands, long long* o_checked)
+	{
+		const auto check = VerifyEveryFace(_case, o_hands, o_checked);
+		if (check != TOTAL_VERIFY_CHECKS || _case->m_hands[0].m_size == c_maxHandSize || GetTotalHandValue(&_case->m_hands[0], 1) > 21)
+		{
+			return check;
+		}
+
+		for (auto rank = _minRank; rank < TOTAL_RANKS; rank++)
+		{
+			_case->m_hands[0].m_cards[_case->m_hands[0].m_size++] = { SUIT_HEARTS, (eRank)rank, true };
+
+			const auto innerCheck = VerifyEveryHand(_case, rank, o_hands, o_checked);
+			if (innerCheck != TOTAL_VERIFY_CHECKS)
+			{
+				return innerCheck;
+			}
+
+			_case->m_hands[0].m_size--;
+		}
+
+		return TOTAL_VERIFY_CHECKS;
+	}
+
+	/// <summary>
+	/// A worker thread's function for the exhaustive comparisons. Claims kept hands one at a time, and compares each against every kept hand.
+	/// </summary>
+	static void RunComparisonWorker(const Hand* _hands, const int* _keptIndices, const int _kept, std::atomic<int>* _nextHand,
+		std::atomic<bool>* _failed, VerifyResult* o_result)
+	{
+		VerifyCase verifyCase{};
+		verifyCase.m_bet = 1;
+
+		for (auto handA = _nextHand->fetch_add(1); handA < _kept && !*_failed; handA = _nextHand->fetch_add(1))
+		{
+			verifyCase.m_hands[0] = _hands[_keptIndices[handA]];
+
+			for (auto handB = 0; handB < _kept; handB++)
+			{
+				verifyCase.m_hands[1] = _hands[_keptIndices[handB]];
+
+				for (const auto aceValue : c_verifyAceValues)
+				{
+					verifyCase.m_aceValue = aceValue;
+
+					const auto check = FindMismatch(&verifyCase);
+					if (check != TOTAL_VERIFY_CHECKS)
+					{
+						o_result->m_failure = verifyCase;
+						o_result->m_check = check;
+						*_failed = true;
+						return;
+					}
+					o_result->m_cases++;
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// A worker thread's function for the random cases. Claims batches of cases until there are none left, or something doesn't match.
+	/// </summary>
+	static void RunRandomWorker(const unsigned long long _seed, const long long _batches, std::atomic<long long>* _nextBatch,
+		std::atomic<bool>* _failed, VerifyResult* o_result)
+	{
+		VerifyCase verifyCase{};
+		Random random;
+
+		for (auto batch = _nextBatch->fetch_add(1); batch < _batches && !*_failed; batch = _nextBatch->fetch_add(1))
+		{
+			SeedRandom(&random, DeriveSeed(_seed, (unsigned long long)batch));
+
+			for (auto caseIndex = 0; caseIndex < c_verifyBatchSize; caseIndex++)
+			{
+				GenerateVerifyCase(&random, &verifyCase);
+
+				const auto check = FindMismatch(&verifyCase);
+				if (check != TOTAL_VERIFY_CHECKS)
+				{
+					o_result->m_failure = verifyCase;
+					o_result->m_check = check;
+					*_failed = true;
+					return;
+				}
+			}
+			o_result->m_cases += c_verifyBatchSize;
+		}
+	}
+
+	/// <summary>
+	/// Display everything about a failing case, with what the reference and optimised rules each made of it.
+	/// </summary>
+	static void DisplayMismatch(VerifyCase* _case, const eVerifyCheck _check)
+	{
+		std::cout << "\nMismatch in " << c_verifyCheckNames[_check] << ". Smallest failing case:\n";
+
+		PackedHand packed[c_verifyHands];
+		for (auto hand = 0; hand < c_verifyHands; hand++)
+		{
+			packed[hand] = PackHand(&_case->m_hands[hand]);
+
+			std::cout << GetPlayerName(hand == 0 ? PLAYER_PLAYER : PLAYER_DEALER) << " Hand:";
+			for (auto cardIndex = 0; cardIndex < _case->m_hands[hand].m_size; cardIndex++)
+			{
+				char cardName[c_maxCardNameSize];
+				GetCardName(&_case->m_hands[hand].m_cards[cardIndex], cardName);
+				std::cout << (cardIndex > 0 ? ", " : " ") << (_case->m_hands[hand].m_cards[cardIndex].m_visible ? "" : "(Face-Down) ") << cardName;
+			}
+
+			std::cout << "\n    Value: " << GetTotalHandValue(&_case->m_hands[hand], _case->m_aceValue) << " (Optimised: " <<
+				GetPackedHandValue(packed[hand], _case->m_aceValue) << "), Validity: " << IsHandValid(&_case->m_hands[hand], _case->m_aceValue) <<
+				" (Optimised: " << GetPackedHandValidity(packed[hand], _case->m_aceValue) << ")\n";
+		}
+
+		const auto result = CompareHands(&_case->m_hands[0], &_case->m_hands[1], _case->m_aceValue);
+		std::cout << "Aces Worth: " << _case->m_aceValue << ", Bet: " << _case->m_bet << "\n";
+		std::cout << "Comparison: " << result << " (Optimised: " << ComparePackedHands(packed[0], packed[1], _case->m_aceValue) <<
+			"), Payout: " << GetPayout(result, _case->m_bet) << " (Optimised: " << GetPackedPayout(result, _case->m_bet) << ")\n\n";
+	}
+
+	eVerifyCheck FindMismatch(VerifyCase* _case)
+	{
+		PackedHand packed[c_verifyHands];
+
+		for (auto hand = 0; hand < c_verifyHands; hand++)
+		{
+			packed[hand] = PackHand(&_case->m_hands[hand]);
+
+			if (GetTotalHandValue(&_case->m_hands[hand], _case->m_aceValue) != GetPackedHandValue(packed[hand], _case->m_aceValue))
+			{
+				return VERIFY_CHECK_VALUE;
+			}
+
+			if (IsHandValid(&_case->m_hands[hand], _case->m_aceValue) != GetPackedHandValidity(packed[hand], _case->m_aceValue))
+			{
+				return VERIFY_CHECK_VALIDITY;
+			}
+		}
+
+		const auto result = CompareHands(&_case->m_hands[0], &_case->m_hands[1], _case->m_aceValue);
+		if (result != ComparePackedHands(packed[0], packed[1], _case->m_aceValue))
+		{
+			return VERIFY_CHECK_COMPARISON;
+		}
+
+		// The payout is checked with the reference result, so a comparison mismatch can never hide a payout mismatch.
+		if (GetPayout(result, _case->m_bet) != GetPackedPayout(result, _case->m_bet))
+		{
+			return VERIFY_CHECK_PAYOUT;
+		}
+
+		return TOTAL_VERIFY_CHECKS;
+	}
+
+	void ShrinkMismatch(VerifyCase* _case, const eVerifyCheck _check)
+	{
+		// Each change is only kept if the case still fails the same check. This repeats until nothing else can be changed.
+		auto shrunk = true;
+		while (shrunk)
+		{
+			shrunk = false;
+
+			for (auto hand = 0; hand < c_verifyHands; hand++)
+			{
+				// Cards are removed from the back, so that a face-down first card stays first for as long as it can.
+				for (auto cardIndex = _case->m_hands[hand].m_size - 1; cardIndex >= 0; cardIndex--)
+				{
+					auto candidate = *_case;
+					RemoveVerifyCard(&candidate, hand, cardIndex);
+					if (FindMismatch(&candidate) == _check)
+					{
+						*_case = candidate;
+						shrunk = true;
+					}
+				}
+
+				for (auto cardIndex = 0; cardIndex < _case->m_hands[hand].m_size; cardIndex++)
+				{
+					auto* card = &_case->m_hands[hand].m_cards[cardIndex];
+
+					// The lowest rank that still fails is kept.
+					for (auto rank = 0; rank < card->m_rank; rank++)
+					{
+						auto candidate = *_case;
+						candidate.m_hands[hand].m_cards[cardIndex].m_rank = (eRank)rank;
+						if (FindMismatch(&candidate) == _check)
+						{
+							*_case = candidate;
+							shrunk = true;
+							break;
+						}
+					}
+
+					if (card->m_suit != SUIT_HEARTS || !card->m_visible)
+					{
+						auto candidate = *_case;
+						candidate.m_hands[hand].m_cards[cardIndex].m_suit = SUIT_HEARTS;
+						candidate.m_hands[hand].m_cards[cardIndex].m_visible = true;
+						if (FindMismatch(&candidate) == _check)
+						{
+							*_case = candidate;
+							shrunk = true;
+						}
+					}
+				}
+			}
+
+			if (_case->m_aceValue != 1)
+			{
+				auto candidate = *_case;
+				candidate.m_aceValue = 1;
+				if (FindMismatch(&candidate) == _check)
+				{
+					*_case = candidate;
+					shrunk = true;
+				}
+			}
+
+			// The bet is tried at 1, then halved, then lowered by 1. Halving gets a large bet down quickly, and lowering finishes it off.
+			const int bets[] = { 1, _case->m_bet / 2, _case->m_bet - 1 };
+			for (const auto bet : bets)
+			{
+				if (bet < 1 || bet >= _case->m_bet)
+				{
+					continue;
+				}
+
+				auto candidate = *_case;
+				candidate.m_bet = bet;
+				if (FindMismatch(&candidate) == _check)
+				{
+					*_case = candidate;
+					shrunk = true;
+					break;
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// Get the settings of a simulation that the lockstep engine supports, with everything that changes how a session plays out chosen randomly.
+	/// </summary>
+	static SimulationSettings GetRandomSimulationSettings(Random* _random)
+	{
+		SimulationSettings settings{};
+		settings.m_decks = RandomRange(_random, c_maxShoeDecks) + 1;
+		settings.m_aceValue = c_verifyAceValues[RandomRange(_random, 2)];
+		settings.m_standThreshold = RandomRange(_random, 10) + 12;
+		settings.m_basicStrategy = RandomRange(_random, 2) == 0;
+
+		const auto baseBet = RandomRange(_random, 10) + 1;
+		settings.m_betPolicy = GetDefaultBetPolicy((eBetPolicy)RandomRange(_random, TOTAL_BET_POLICIES), baseBet, baseBet * (RandomRange(_random, 16) + 1));
+
+		// Sessions are long enough to reshuffle the shoe many times, and the stops are only set sometimes.
+		settings.m_startingBank = c_startingBank;
+		settings.m_maxRounds = RandomRange(_random, 1000) + 1;
+		settings.m_stopWin = RandomRange(_random, 2) == 0 ? c_startingBank + RandomRange(_random, c_startingBank) + 1 : 0;
+		settings.m_stopLoss = RandomRange(_random, 2) == 0 ? RandomRange(_random, c_startingBank) : 0;
+
+		settings.m_sessions = c_verifySimulationSessions;
+		settings.m_seed = NextRandom(_random);
+		settings.m_exportFormat = EXPORT_FORMAT_NONE;
+		return settings;
+	}
+
+	int RunVerification(const long long _randomCases, const unsigned long long _seed)
+	{
+		const auto threadCount = (int)std::thread::hardware_concurrency() > 0 ? (int)std::thread::hardware_concurrency() : 1;
+		auto* threads = new std::thread[threadCount];
+		auto* results = new VerifyResult[threadCount]{};
+
+		// Every hand that can be dealt, up to the most cards a hand can have, each checked on its own against an empty hand.
+		std::cout << "Checking every hand that can be dealt, up to " << c_maxHandSize << " cards...\n" << std::flush;
+		auto start = std::chrono::steady_clock::now();
+
+		auto* hands = new Hand[c_packedHandValues];
+		for (auto handIndex = 0; handIndex < c_packedHandValues; handIndex++)
+		{
+			hands[handIndex].m_size = -1;
+		}
+
+		auto* verifyCase = new VerifyCase{};
+		verifyCase->m_bet = 1;
+
+		auto checked = 0ll;
+		auto check = VerifyEveryHand(verifyCase, 0, hands, &checked);
+
+		// Then every kept hand against every other, which covers every comparison between different hands.
+		if (check == TOTAL_VERIFY_CHECKS)
+		{
+			auto* keptIndices = new int[c_packedHandValues];
+			auto kept = 0;
+			for (auto handIndex = 0; handIndex < c_packedHandValues; handIndex++)
+			{
+				if (hands[handIndex].m_size >= 0)
+				{
+					keptIndices[kept++] = handIndex;
+				}
+			}
+
+			std::atomic<int> nextHand(0);
+			std::atomic<bool> failed(false);
+			for (auto threadIndex = 0; threadIndex < threadCount; threadIndex++)
+			{
+				results[threadIndex].m_check = TOTAL_VERIFY_CHECKS;
+				threads[threadIndex] = std::thread(RunComparisonWorker, hands, keptIndices, kept, &nextHand, &failed, &results[threadIndex]);
+			}
+			for (auto threadIndex = 0; threadIndex < threadCount; threadIndex++)
+			{
+				threads[threadIndex].join();
+			}
+
+			auto comparisons = 0ll;
+			for (auto threadIndex = 0; threadIndex < threadCount; threadIndex++)
+			{
+				comparisons += results[threadIndex].m_cases;
+				if (check == TOTAL_VERIFY_CHECKS && results[threadIndex].m_check != TOTAL_VERIFY_CHECKS)
+				{
+					*verifyCase = results[threadIndex].m_failure;
+					check = results[threadIndex].m_check;
+				}
+			}
+
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			std::cout << "Checked " << checked << " hands and " << comparisons << " comparisons between " << kept << " distinct hands in " <<
+				std::fixed << std::setprecision(2) << elapsed.count() << " seconds.\n" << std::flush;
+
+			delete[] keptIndices;
+		}
+		delete[] hands;
+
+		// Every result with every bet the optimised payout is meant to be exact for.
+		// These can't be shrunk any further, since the first mismatch found is already the smallest bet.
+		if (check == TOTAL_VERIFY_CHECKS)
+		{
+			std::cout << "Checking every payout up to a bet of " << c_maxPackedPayoutBet << "...\n" << std::flush;
+			for (auto result = 0; result <= HAND_COMPARISON_NATURAL; result++)
+			{
+				for (auto bet = 1; bet <= c_maxPackedPayoutBet; bet++)
+				{
+					if (GetPayout((eHandValidityComparison)result, bet) != GetPackedPayout((eHandValidityComparison)result, bet))
+					{
+						std::cout << "\nMismatch in " << c_verifyCheckNames[VERIFY_CHECK_PAYOUT] << ". Result: " << result << ", Bet: " << bet <<
+							", Payout: " << GetPayout((eHandValidityComparison)result, bet) << " (Optimised: " <<
+							GetPackedPayout((eHandValidityComparison)result, bet) << ")\n\n";
+
+						delete verifyCase;
+						delete[] results;
+						delete[] threads;
+						return 1;
+					}
+				}
+			}
+		}
+
+		// Random pairs of hands, with random bets, across every thread.
+		if (check == TOTAL_VERIFY_CHECKS)
+		{
+			const auto batches = (_randomCases + c_verifyBatchSize - 1) / c_verifyBatchSize;
+			std::cout << "Checking " << batches * c_verifyBatchSize << " random cases (Seed: " << _seed << ")...\n" << std::flush;
+			start = std::chrono::steady_clock::now();
+
+			std::atomic<long long> nextBatch(0);
+			std::atomic<bool> failed(false);
+			for (auto threadIndex = 0; threadIndex < threadCount; threadIndex++)
+			{
+				results[threadIndex] = {};
+				results[threadIndex].m_check = TOTAL_VERIFY_CHECKS;
+				threads[threadIndex] = std::thread(RunRandomWorker, _seed, batches, &nextBatch, &failed, &results[threadIndex]);
+			}
+			for (auto threadIndex = 0; threadIndex < threadCount; threadIndex++)
+			{
+				threads[threadIndex].join();
+			}
+
+			auto cases = 0ll;
+			for (auto threadIndex = 0; threadIndex < threadCount; threadIndex++)
+			{
+				cases += results[threadIndex].m_cases;
+				if (check == TOTAL_VERIFY_CHECKS && results[threadIndex].m_check != TOTAL_VERIFY_CHECKS)
+				{
+					*verifyCase = results[threadIndex].m_failure;
+					check = results[threadIndex].m_check;
+				}
+			}
+
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			std::cout << "Checked " << cases << " random cases in " << std::setprecision(2) << elapsed.count() << " seconds (" <<
+				std::setprecision(0) << (double)cases / elapsed.count() << " per second).\n" << std::flush;
+		}
+
+		delete[] results;
+		delete[] threads;
+
+		if (check != TOTAL_VERIFY_CHECKS)
+		{
+			ShrinkMismatch(verifyCase, check);
+			DisplayMismatch(verifyCase, check);
+
+			delete verifyCase;
+			return 1;
+		}
+
+		// Whole simulations, played by the scalar engine and by the lockstep engine with every instruction set this CPU has.
+		SimulationSettings settings{};
+		const auto* unsupportedReason = GetLockstepUnsupportedReason(&settings);
+		if (unsupportedReason != nullptr)
+		{
+			std::cout << "Skipping the lockstep engine, since " << unsupportedReason << ".\n";
+		}
+		else
+		{
+			std::cout << "Checking " << c_verifySimulations << " simulations of " << c_verifySimulationSessions << " sessions in lockstep, up to " <<
+				GetInstructionSetName(GetSupportedInstructionSet()) << "...\n" << std::flush;
+			start = std::chrono::steady_clock::now();
+
+			Random random;
+			SeedRandom(&random, DeriveSeed(_seed, c_verifySimulations));
+			for (auto simulation = 0; simulation < c_verifySimulations; simulation++)
+			{
+				settings = GetRandomSimulationSettings(&random);
+
+				const auto mismatch = FindLockstepMismatch(&settings);
+				if (mismatch >= 0)
+				{
+					std::cout << "\nMismatch in the lockstep engine. Session: " << mismatch << ", Seed: " << settings.m_seed << ", Decks: " << settings.m_decks <<
+						", Ace Value: " << settings.m_aceValue << ", Strategy: ";
+					if (settings.m_basicStrategy)
+					{
+						std::cout << "Basic";
+					}
+					else
+					{
+						std::cout << "Stand Threshold " << settings.m_standThreshold;
+					}
+					std::cout << ", Bet Policy: " << GetBetPolicyName(settings.m_betPolicy.m_type) << "\n\n";
+
+					delete verifyCase;
+					return 1;
+				}
+			}
+
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			std::cout << "Checked " << c_verifySimulations * c_verifySimulationSessions << " sessions in " << std::setprecision(2) << elapsed.count() <<
+				" seconds.\n" << std::flush;
+		}
+
+		std::cout << "\nEvery check matched.\n";
+
+		delete verifyCase;
+		return 0;
+	}
+}
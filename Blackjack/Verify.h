@@ -0,0 +1,84 @@
+#pragma once
+
+#ifndef VERIFY_H_
+#define VERIFY_H_
+
+#include "Hand.h"
+
+namespace blackjack
+{
+	/// <summary>
+	/// The command line argument that runs the differential test harness, rather than opening the menu.<br>
+	/// The harness is started as "Blackjack.exe --verify (millions of random cases) (seed)", where both are optional.
+	/// </summary>
+	constexpr char c_verifyArgument[] = "--verify";
+
+	/// <summary>
+	/// The amount of random cases checked if none are given, in millions.
+	/// </summary>
+	constexpr auto c_defaultVerifyCases = 100;
+
+	/// <summary>
+	/// The amount of hands in each case. The first hand is the player's, and the second is the dealer's.
+	/// </summary>
+	constexpr auto c_verifyHands = 2;
+
+	/// <summary>
+	/// Every check made between the reference rules and the optimised ones, in the order they're made.<br>
+	/// Includes a value to refer to for the total amount of checks, which is also used to mean that every check passed.
+	/// </summary>
+	enum eVerifyCheck : int
+	{
+		VERIFY_CHECK_VALUE = 0,
+		VERIFY_CHECK_VALIDITY,
+		VERIFY_CHECK_COMPARISON,
+		VERIFY_CHECK_PAYOUT,
+		TOTAL_VERIFY_CHECKS
+	};
+
+	/// <summary>
+	/// String values for every check, naming the reference function it checks.<br>
+	/// Includes an additional blank value for the TOTAL_VERIFY_CHECKS value.
+	/// </summary>
+	constexpr char c_verifyCheckNames[][18] = { "GetTotalHandValue", "IsHandValid", "CompareHands", "GetPayout", "" };
+
+	/// <summary>
+	/// Everything needed for one check of every rule.
+	/// </summary>
+	struct VerifyCase
+	{
+		/// <summary>
+		/// Both hands. Only the first card of a hand can be face-down, just like the dealer's hole card.
+		/// </summary>
+		Hand m_hands[c_verifyHands];
+
+		int m_aceValue;
+		int m_bet;
+	};
+
+	/// <summary>
+	/// Run every check on a case, comparing the reference rules against the optimised ones.
+	/// </summary>
+	/// <param name="_case">The case to check.</param>
+	/// <returns>The first check that didn't match, or TOTAL_VERIFY_CHECKS if they all did.</returns>
+	eVerifyCheck FindMismatch(VerifyCase* _case);
+
+	/// <summary>
+	/// Make a failing case as small as possible, while it still fails the same check.<br>
+	/// Cards are removed, ranks are lowered, cards are turned face-up, and the bet and ace value are reduced, until none of them can be.
+	/// </summary>
+	/// <param name="_case">The failing case. This is shrunk in place.</param>
+	/// <param name="_check">The check the case fails.</param>
+	void ShrinkMismatch(VerifyCase* _case, eVerifyCheck _check);
+
+	/// <summary>
+	/// The main function of the harness. Every hand that can be dealt (up to "c_maxHandSize" cards) is checked first, then random cases across every thread.<br>
+	/// If anything doesn't match, it's shrunk and displayed.
+	/// </summary>
+	/// <param name="_randomCases">The amount of random cases to check.</param>
+	/// <param name="_seed">The seed for the random cases. The same seed always checks the same cases.</param>
+	/// <returns>The process exit code. 0 if everything matched.</returns>
+	int RunVerification(long long _randomCases, unsigned long long _seed);
+}
+
+#endif
@@ -1,18 +1,85 @@
 #include <iostream>
+#include <cstring>
 #include <ctime>
 #include <windows.h>
 
 #include "Menu.h"
+#include "Query.h"
+#include "Server.h"
+#include "SessionPool.h"
+#include "Shard.h"
+#include "ShoeLibrary.h"
+#include "Trace.h"
+#include "Tracepoints.h"
+#include "Verify.h"
 
-int main()
+int main(int argc, char* argv[])
 {
-	// Sets the window title displayed at the top of the console. This is a Windows-exclusive function.
-	SetConsoleTitle(TEXT("Blackjack"));
+	// Tracepoints are registered before anything else, so that shard workers and the server can be traced just like the menu.
+	blackjack::RegisterTracepoints();
+
+	// Worker processes for a sharded simulation skip the menu entirely. They're started by the coordinator, never by a user.
+	if (argc == 4 && strcmp(argv[1], blackjack::c_shardArgument) == 0)
+	{
+		return blackjack::RunShardWorker(argv[2], atoi(argv[3]));
+	}
 
 	// Seeds the rand() function based on the user's current system time.
 	// This only needs to be run once - running it more could at best be pointless be pointless and at worst enable exploits.
 	srand(time(nullptr));
 
+	// The server and its load generator don't use the menu either, but unlike shard workers they're started by a user.
+	if (argc >= 2 && strcmp(argv[1], blackjack::c_serverArgument) == 0)
+	{
+		const auto port = argc >= 3 ? (unsigned short)atoi(argv[2]) : blackjack::c_defaultServerPort;
+		const auto capacity = argc >= 4 ? atoi(argv[3]) : blackjack::c_defaultSessionPoolSize;
+
+		return blackjack::RunServer(port, capacity < 1 ? 1 : capacity > blackjack::c_maxConnections ? blackjack::c_maxConnections : capacity);
+	}
+	if (argc >= 4 && strcmp(argv[1], blackjack::c_loadArgument) == 0)
+	{
+		return blackjack::RunLoadGenerator(atoi(argv[2]), atoll(argv[3]), argc >= 5 ? (unsigned short)atoi(argv[4]) : blackjack::c_defaultServerPort);
+	}
+
+	// The differential test harness is given its seed, so that a failing run can be repeated exactly.
+	if (argc >= 2 && strcmp(argv[1], blackjack::c_verifyArgument) == 0)
+	{
+		const auto cases = argc >= 3 ? atoll(argv[2]) : blackjack::c_defaultVerifyCases;
+		const auto seed = argc >= 4 ? strtoull(argv[3], nullptr, 10) : (unsigned long long)rand() << 32 | (unsigned long long)rand();
+
+		return blackjack::RunVerification(cases * 1000000ll, seed);
+	}
+
+	// Queries only read a file that has already been exported, so they're answered straight away without the menu.
+	if (argc >= 3 && strcmp(argv[1], blackjack::c_queryArgument) == 0)
+	{
+		return blackjack::RunQueryCommand(argv[2], &argv[3], argc - 3);
+	}
+
+	// Libraries of shoes are generated for simulations to deal from later on. They're given their seed, so a library can be generated again.
+	if (argc >= 5 && strcmp(argv[1], blackjack::c_generateShoesArgument) == 0)
+	{
+		const auto seed = argc >= 6 ? strtoull(argv[5], nullptr, 10) : (unsigned long long)rand() << 32 | (unsigned long long)rand();
+
+		return blackjack::RunGenerateShoesCommand(argv[2], atoll(argv[3]), atoi(argv[4]), seed);
+	}
+
+	// Sets the window title displayed at the top of the console. This is a Windows-exclusive function.
+	SetConsoleTitle(TEXT("Blackjack"));
+
+	// Recorded games are played on the console like any other, so they and their replays get the window title too.
+	if (argc >= 3 && strcmp(argv[1], blackjack::c_recordArgument) == 0)
+	{
+		return blackjack::RunRecording(argv[2]);
+	}
+	if (argc >= 3 && strcmp(argv[1], blackjack::c_replayArgument) == 0)
+	{
+		const auto replays = argc >= 4 ? atoi(argv[3]) : blackjack::c_defaultReplays;
+		const auto budget = argc >= 5 ? atoll(argv[4]) : 0ll;
+
+		return blackjack::RunReplay(argv[2], replays < 1 ? 1 : replays, budget);
+	}
+
 	// Enter the menu function. All subsequent game logic is handled here.
 	blackjack::MenuLoop();
 	